@@ -1,5 +1,7 @@
 #ifndef NOX_ECS_COMPONENT_H_
 #define NOX_ECS_COMPONENT_H_
+#include <iosfwd>
+
 #include <nox/common/types.h>
 #include <nox/ecs/EntityId.h>
 #include <nox/ecs/Event.h>
@@ -76,6 +78,17 @@ namespace nox
              */
             Component& operator=(Component&&) = default;
 
+            /**
+             * @brief      Overridable trait, set to true in a component type
+             *             to let the factory initialize one prototype per
+             *             definition, and copy it for every entity created
+             *             from that definition. Only valid if initialize
+             *             depends on nothing but the json value and has no
+             *             side effects, as it is skipped for the copies. The
+             *             type must be copyable.
+             */
+            static constexpr bool cloneable = false;
+
             /**
              * @brief      Overridable initialize function.
              *
@@ -135,6 +148,28 @@ namespace nox
              */
             void
             receiveEntityEvent(const ecs::Event& /*event*/) {}
+
+            /**
+             * @brief      Overridable writeBinary function. For writing the
+             *             component into a snapshot, see
+             *             EntityManager::saveSnapshot. Only needed for
+             *             components that are not trivially copyable, and
+             *             must be overridden together with readBinary.
+             *
+             * @param      stream  The stream to write to.
+             */
+            void
+            writeBinary(std::ostream& /*stream*/) const {}
+
+            /**
+             * @brief      Overridable readBinary function. For reading back
+             *             what writeBinary wrote, into a constructed but not
+             *             initialized component.
+             *
+             * @param      stream  The stream to read from.
+             */
+            void
+            readBinary(std::istream& /*stream*/) {}
         };
     }
 }
@@ -3,6 +3,54 @@
 
 #include <cstdlib>
 
+namespace
+{
+    namespace local
+    {
+        /**
+         * @brief      Start of a collection within a snapshot. The counts
+         *             give the boundaries between the lifecycle areas.
+         */
+        struct SnapshotHeader
+        {
+            std::uint64_t size;
+            std::uint64_t triviallyCopyable;
+            std::uint64_t count;
+            std::uint64_t activeCount;
+            std::uint64_t inactiveCount;
+            std::uint64_t changeTick;
+        };
+
+        /**
+         * @brief      An entry of the id index within a snapshot, slot is the
+         *             position of the component within the dense storage.
+         */
+        struct IndexEntry
+        {
+            std::uint64_t id;
+            std::uint64_t slot;
+        };
+
+        template<class T>
+        void
+        write(std::ostream& stream, const T* data, std::size_t count)
+        {
+            stream.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+        }
+
+        template<class T>
+        bool
+        read(std::istream& stream, T* data, std::size_t count)
+        {
+            const auto size = static_cast<std::streamsize>(count * sizeof(T));
+            stream.read(reinterpret_cast<char*>(data), size);
+            return stream.gcount() == size;
+        }
+    }
+}
+
+constexpr nox::ecs::EntityId nox::ecs::ComponentCollection::PROTOTYPE_ID;
+
 nox::ecs::ComponentCollection::ComponentCollection(const MetaInformation& info)
     : info(info)
     , gen(0)
@@ -18,11 +66,14 @@ nox::ecs::ComponentCollection::ComponentCollection(ComponentCollection&& source)
     : info(std::move(source.info))
     , gen(std::move(source.gen))
     , componentMap(std::move(source.componentMap))
+    , changeTicks(std::move(source.changeTicks))
+    , changeTick(source.changeTick)
     , active(std::move(source.active))
     , inactive(std::move(source.inactive))
     , hibernating(std::move(source.hibernating))
     , memory(std::move(source.memory))
     , cap(std::move(source.cap))
+    , prototypes(std::move(source.prototypes))
 {
     source.active = nullptr;
     source.inactive = nullptr;
@@ -39,14 +90,19 @@ nox::ecs::ComponentCollection::operator=(ComponentCollection&& source)
     {
         this->destroyRange(this->active, this->memory);
         std::free(this->active);
+        this->destroyPrototypes();
         this->info = std::move(source.info);
         this->gen = std::move(source.gen);
         this->componentMap = std::move(source.componentMap);
+        this->changeTicks = std::move(source.changeTicks);
+        this->changeTick = source.changeTick;
         this->active = std::move(source.active);
         this->inactive = std::move(source.inactive);
         this->hibernating = std::move(source.hibernating);
         this->memory = std::move(source.memory);
         this->cap = std::move(source.cap);
+        this->prototypes = std::move(source.prototypes);
+        source.prototypes.clear();
 
         source.active = nullptr;
         source.inactive = nullptr;
@@ -77,6 +133,8 @@ nox::ecs::ComponentCollection::~ComponentCollection()
     this->hibernating = nullptr;
     this->memory = nullptr;
     this->cap = nullptr;
+
+    this->destroyPrototypes();
 }
 
 void
@@ -92,6 +150,7 @@ nox::ecs::ComponentCollection::create(const EntityId& id,
     this->componentMap.insert(itr, { id, this->cast(this->memory) });
 
     this->info.construct(this->cast(this->memory), id, manager);
+    this->changeTicks.push_back(this->changeTick);
     this->memory += this->info.size;
 }
 
@@ -107,9 +166,57 @@ nox::ecs::ComponentCollection::adopt(Component& component)
     this->componentMap.insert(itr, { component.id, this->cast(this->memory) });
 
     this->info.moveConstruct(this->cast(this->memory), &component);
+    this->changeTicks.push_back(this->changeTick);
     this->memory += this->info.size;
 }
 
+void
+nox::ecs::ComponentCollection::clone(const EntityId& firstId,
+                                     std::size_t count,
+                                     EntityManager* manager,
+                                     const Component& prototype)
+{
+    NOX_ASSERT(this->info.clone, "Component type has no clone operation!\n");
+
+    while (this->size() + count * this->info.size > this->capacity())
+    {
+        this->reallocate();
+    }
+
+    // The ids are contiguous, so all the new entries go into the same spot in the map.
+    auto itr = this->componentMap.insert(this->findBefore(firstId), count, { firstId, nullptr });
+    for (std::size_t i = 0; i < count; ++i, ++itr)
+    {
+        itr->id = firstId + i;
+        itr->component = this->cast(this->memory);
+
+        this->info.clone(itr->component, &prototype, firstId + i, manager);
+        this->memory += this->info.size;
+    }
+    this->changeTicks.resize(this->changeTicks.size() + count, this->changeTick);
+}
+
+const nox::ecs::Component*
+nox::ecs::ComponentCollection::createPrototype(const Json::Value& value,
+                                               EntityManager* manager)
+{
+    if (!this->info.clone)
+    {
+        return nullptr;
+    }
+
+    auto prototype = this->cast(static_cast<Byte*>(std::malloc(this->info.size)));
+    this->prototypes.push_back(reinterpret_cast<Byte*>(prototype));
+
+    this->info.construct(prototype, PROTOTYPE_ID, manager);
+    if (this->info.initialize)
+    {
+        this->info.initialize(prototype, value);
+    }
+
+    return prototype;
+}
+
 void
 nox::ecs::ComponentCollection::initialize(const EntityId& id,
                                           const Json::Value& value)
@@ -213,6 +320,11 @@ nox::ecs::ComponentCollection::remove(const EntityId& id)
 
     if (target != std::end(this->componentMap))
     {
+        // The last component is moved into the slot of the removed one, its tick follows along.
+        const auto slot = this->getSlot(target->component);
+        this->changeTicks[slot] = this->changeTicks.back();
+        this->changeTicks.pop_back();
+
         this->memory -= this->info.size;
         auto swapped = this->find(this->cast(this->memory)->id);
 
@@ -312,6 +424,194 @@ nox::ecs::ComponentCollection::getMetaInformation() const
     return this->info;
 }
 
+void
+nox::ecs::ComponentCollection::setChangeTick(ChangeTick tick)
+{
+    NOX_ASSERT(tick >= this->changeTick, "Change tick must not decrease, was: %u, new: %u",
+               static_cast<unsigned>(this->changeTick), static_cast<unsigned>(tick));
+    this->changeTick = tick;
+}
+
+nox::ecs::ComponentCollection::ChangeTick
+nox::ecs::ComponentCollection::getChangeTick() const
+{
+    return this->changeTick;
+}
+
+void
+nox::ecs::ComponentCollection::markChanged(const Component* component)
+{
+    // Copies of a component, e.g. a Transform kept on the stack, are not stamped.
+    const auto bytes = reinterpret_cast<const Byte*>(component);
+    if (bytes >= this->active && bytes < this->memory)
+    {
+        this->changeTicks[this->getSlot(component)] = this->changeTick;
+    }
+}
+
+void
+nox::ecs::ComponentCollection::markChanged(const EntityId& id)
+{
+    auto target = this->find(id);
+    if (target != std::end(this->componentMap))
+    {
+        this->markChanged(target->component);
+    }
+}
+
+bool
+nox::ecs::ComponentCollection::isSerializable() const
+{
+    return this->count() == 0 ||
+           this->info.triviallyCopyable ||
+           (this->info.serialize && this->info.deserialize);
+}
+
+bool
+nox::ecs::ComponentCollection::writeSnapshot(std::ostream& stream) const
+{
+    if (!this->isSerializable())
+    {
+        return false;
+    }
+
+    const local::SnapshotHeader header{ this->info.size,
+                                        this->info.triviallyCopyable,
+                                        this->count(),
+                                        std::size_t(this->inactive - this->active) / this->info.size,
+                                        std::size_t(this->hibernating - this->inactive) / this->info.size,
+                                        this->changeTick };
+    local::write(stream, &header, 1);
+
+    std::vector<local::IndexEntry> index;
+    index.reserve(this->componentMap.size());
+    for (const auto& item : this->componentMap)
+    {
+        index.push_back({ item.id, this->getSlot(item.component) });
+    }
+    local::write(stream, index.data(), index.size());
+    local::write(stream, this->changeTicks.data(), this->changeTicks.size());
+
+    if (this->info.triviallyCopyable)
+    {
+        local::write(stream, this->active, this->size());
+    }
+    else
+    {
+        for (auto begin = this->active; begin != this->memory; begin += this->info.size)
+        {
+            this->info.serialize(this->cast(begin), stream);
+        }
+    }
+
+    return stream.good();
+}
+
+bool
+nox::ecs::ComponentCollection::readSnapshot(std::istream& stream,
+                                            EntityManager* manager)
+{
+    // Also checked in release builds, reading into a populated collection corrupts it.
+    if (this->count() != 0)
+    {
+        return false;
+    }
+
+    local::SnapshotHeader header{};
+    if (!local::read(stream, &header, 1) ||
+        header.size != this->info.size ||
+        header.triviallyCopyable != this->info.triviallyCopyable ||
+        header.activeCount > header.count ||
+        header.inactiveCount > header.count - header.activeCount ||
+        (header.count != 0 && !this->info.triviallyCopyable && !this->info.deserialize))
+    {
+        return false;
+    }
+
+    const auto count = static_cast<std::size_t>(header.count);
+    std::vector<local::IndexEntry> index(count);
+    std::vector<ChangeTick> changeTicks(count);
+    if (!local::read(stream, index.data(), count) ||
+        !local::read(stream, changeTicks.data(), count))
+    {
+        return false;
+    }
+
+    // The index must be sorted like the componentMap, and cover every slot once.
+    std::vector<EntityId> slotIds(count);
+    std::vector<bool> indexed(count, false);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto& entry = index[i];
+        if (entry.slot >= count ||
+            indexed[entry.slot] ||
+            (i != 0 && index[i - 1].id >= entry.id))
+        {
+            return false;
+        }
+
+        indexed[entry.slot] = true;
+        slotIds[entry.slot] = entry.id;
+    }
+
+    while (count * this->info.size > this->capacity())
+    {
+        this->reallocate();
+    }
+
+    if (this->info.triviallyCopyable)
+    {
+        if (!local::read(stream, this->active, count * this->info.size))
+        {
+            return false;
+        }
+
+        // The ids are part of the bytes, only the manager needs fixing up.
+        for (std::size_t slot = 0; slot < count; ++slot)
+        {
+            auto component = this->cast(this->active + slot * this->info.size);
+            if (component->id != slotIds[slot])
+            {
+                return false;
+            }
+            component->entityManager = manager;
+        }
+        this->memory = this->active + count * this->info.size;
+    }
+    else
+    {
+        for (std::size_t slot = 0; slot < count; ++slot)
+        {
+            auto component = this->cast(this->memory);
+            this->info.construct(component, slotIds[slot], manager);
+            this->memory += this->info.size;
+
+            this->info.deserialize(component, stream);
+            if (!stream)
+            {
+                this->destroyRange(this->active, this->memory);
+                this->memory = this->active;
+                return false;
+            }
+        }
+    }
+
+    this->inactive = this->active + header.activeCount * this->info.size;
+    this->hibernating = this->inactive + header.inactiveCount * this->info.size;
+
+    this->componentMap.reserve(count);
+    for (const auto& entry : index)
+    {
+        this->componentMap.push_back({ entry.id, this->cast(this->active + entry.slot * this->info.size) });
+    }
+
+    this->changeTicks = std::move(changeTicks);
+    this->changeTick = static_cast<ChangeTick>(header.changeTick);
+    this->gen++;
+
+    return true;
+}
+
 nox::ecs::Component*
 nox::ecs::ComponentCollection::cast(Byte* entity) const
 {
@@ -431,6 +731,7 @@ nox::ecs::ComponentCollection::swap(Component* lhs,
         this->info.moveAssign(rhs, lhs);
         this->info.moveAssign(lhs, swapArea);
         this->info.destruct(swapArea);
+        std::swap(this->changeTicks[this->getSlot(lhs)], this->changeTicks[this->getSlot(rhs)]);
         this->gen++;
     }
 }
@@ -450,3 +751,23 @@ nox::ecs::ComponentCollection::updateWholeMap()
         begin += this->info.size;
     }
 }
+
+std::size_t
+nox::ecs::ComponentCollection::getSlot(const Component* component) const
+{
+    const auto offset = reinterpret_cast<const Byte*>(component) - this->active;
+    NOX_ASSERT(offset >= 0 && reinterpret_cast<const Byte*>(component) < this->memory,
+               "Component does not belong to this collection!");
+    return static_cast<std::size_t>(offset) / this->info.size;
+}
+
+void
+nox::ecs::ComponentCollection::destroyPrototypes()
+{
+    for (auto prototype : this->prototypes)
+    {
+        this->info.destruct(this->cast(prototype));
+        std::free(prototype);
+    }
+    this->prototypes.clear();
+}
@@ -1,7 +1,11 @@
 #ifndef NOX_ECS_COMPONENTCOLLECTION_H_
 #define NOX_ECS_COMPONENTCOLLECTION_H_
 #include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
 #include <memory>
+#include <ostream>
 #include <vector>
 
 #include <nox/common/types.h>
@@ -43,6 +47,16 @@ namespace nox
         class ComponentCollection
         {
         public:
+            /**
+             * @brief      Tick used to track when components were changed.
+             */
+            using ChangeTick = std::uint32_t;
+
+            /**
+             * @brief      The id given to prototypes, see createPrototype.
+             */
+            static constexpr EntityId PROTOTYPE_ID = std::numeric_limits<EntityId>::max();
+
             /**
              * @brief      Default construction of ComponentCollection is
              *             illegal. MetaInformation is needed.
@@ -128,6 +142,46 @@ namespace nox
             void
             adopt(Component& component);
 
+            /**
+             * @brief      Creates a component for each of the ids [firstId,
+             *             firstId + count) as a copy of prototype, using the
+             *             clone operation of the MetaInformation. The
+             *             components are initialized, but not awake or
+             *             activated. None of the ids can already have a
+             *             component in the collection.
+             *
+             * @param[in]  firstId        the id of the entity the first new
+             *                            component belongs to.
+             * @param[in]  count          the number of components to create.
+             * @param      entityManager  The entityManager controlling the
+             *                            components.
+             * @param[in]  prototype      The prototype to copy, created by
+             *                            createPrototype.
+             */
+            void
+            clone(const EntityId& firstId,
+                  std::size_t count,
+                  EntityManager* entityManager,
+                  const Component& prototype);
+
+            /**
+             * @brief      Creates a prototype initialized with value, which
+             *             components can be cloned from. The prototype is not
+             *             part of the collection, it has the id PROTOTYPE_ID,
+             *             and lives as long as the collection.
+             *
+             * @param[in]  value          the value to initialize the
+             *                            prototype with.
+             * @param      entityManager  The entityManager controlling the
+             *                            components.
+             *
+             * @return     The prototype, or nullptr if the component type has
+             *             no clone operation.
+             */
+            const Component*
+            createPrototype(const Json::Value& value,
+                            EntityManager* entityManager);
+
             /**
              * @brief      Initializes the component with the specified id with
              *             the values from the value parameter.
@@ -280,6 +334,113 @@ namespace nox
             const MetaInformation&
             getMetaInformation() const;
 
+            /**
+             * @brief      Sets the tick that components marked as changed from
+             *             now on are stamped with. Must increase over time,
+             *             and must not be called concurrently with markChanged.
+             *
+             * @param[in]  tick  The new tick.
+             */
+            void
+            setChangeTick(ChangeTick tick);
+
+            /**
+             * @brief      Returns the tick components are currently stamped
+             *             with when marked as changed.
+             *
+             * @return     The current change tick.
+             */
+            ChangeTick
+            getChangeTick() const;
+
+            /**
+             * @brief      Stamps the component with the current change tick.
+             *             Components are also stamped when created. Can be
+             *             called concurrently for different components, e.g.
+             *             from within update. Nothing happens if the
+             *             component is not stored in this collection.
+             *
+             * @param[in]  component  The component to stamp.
+             */
+            void
+            markChanged(const Component* component);
+
+            /**
+             * @brief      Stamps the component belonging to the entity
+             *             identified by id with the current change tick.
+             *             Nothing happens if the component is not found.
+             *
+             * @param[in]  id    the id of the entity the component belongs to.
+             */
+            void
+            markChanged(const EntityId& id);
+
+            /**
+             * @brief      Calls function on every component, regardless of
+             *             lifecycle state, that has been marked as changed
+             *             after since. Only the ticks are read for unchanged
+             *             components, not the components themselves.
+             *
+             * @param[in]  since     The tick to compare against, usually the
+             *                       change tick from when the caller last
+             *                       looked. 0 visits all components.
+             * @param[in]  function  Called as function(Component&).
+             */
+            template<class Function>
+            void
+            forEachChanged(ChangeTick since, const Function& function);
+
+            /**
+             * @brief      Checks if the collection can be written to a
+             *             snapshot, i.e. it is empty, or the components are
+             *             trivially copyable or have serialize and
+             *             deserialize operations.
+             *
+             * @return     true if writeSnapshot can write the collection.
+             */
+            bool
+            isSerializable() const;
+
+            /**
+             * @brief      Writes the collection into a snapshot. The dense
+             *             storage is written as is, with the boundaries
+             *             between the active, inactive and hibernating
+             *             areas, the id index, and the change ticks, so it
+             *             can be restored without any searching or sorting.
+             *             Trivially copyable components are written in a
+             *             single write, others through the serialize
+             *             operation.
+             *
+             * @param      stream  The stream to write to, must be opened in
+             *                     binary mode.
+             *
+             * @return     false if the collection is not serializable, or
+             *             the stream failed.
+             */
+            bool
+            writeSnapshot(std::ostream& stream) const;
+
+            /**
+             * @brief      Restores a collection written by writeSnapshot
+             *             into this collection, which must be empty. The
+             *             components are put back in the same lifecycle
+             *             state, without any lifecycle operations being
+             *             called.
+             *
+             * @param      stream         The stream to read from, must be
+             *                            opened in binary mode.
+             * @param      entityManager  The entityManager controlling the
+             *                            components.
+             *
+             * @return     false if the collection is not empty, or the
+             *             snapshot does not match the component type or is
+             *             malformed. The collection is left as it was in
+             *             that case.
+             */
+            bool
+            readSnapshot(std::istream& stream,
+                         EntityManager* entityManager);
+
         private:
             /**
              * @brief      Used within the IndexMap, allowing for faster searches.
@@ -411,6 +572,18 @@ namespace nox
             void
             updateWholeMap();
 
+            /**
+             * @brief      Destroys and frees all prototypes.
+             */
+            void
+            destroyPrototypes();
+
+            /**
+             * @brief      Returns the slot index of component.
+             */
+            std::size_t
+            getSlot(const Component* component) const;
+
             /**
              * @brief      Growth factor describing how much the capacity should
              *             grow per reallocation.
@@ -422,13 +595,28 @@ namespace nox
 
             IndexMap componentMap{};
 
+            /**
+             * @brief      The tick each slot was last changed at, follows the
+             *             components as they are moved between slots.
+             */
+            std::vector<ChangeTick> changeTicks{};
+            ChangeTick changeTick{1};
+
             Byte* active{};
             Byte* inactive{};
             Byte* hibernating{};
             Byte* memory{};
             Byte* cap{};
+
+            /**
+             * @brief      Storage of the prototypes, each is allocated on
+             *             its own so they never move.
+             */
+            std::vector<Byte*> prototypes{};
         };
     }
 }
 
+#include <nox/ecs/ComponentCollection.tpp>
+
 #endif
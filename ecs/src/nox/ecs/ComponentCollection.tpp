@@ -0,0 +1,12 @@
+template<class Function>
+void
+nox::ecs::ComponentCollection::forEachChanged(ChangeTick since, const Function& function)
+{
+    for (std::size_t i = 0; i < this->changeTicks.size(); ++i)
+    {
+        if (this->changeTicks[i] > since)
+        {
+            function(*this->cast(this->active + i * this->info.size));
+        }
+    }
+}
@@ -1,8 +1,10 @@
 #include <nox/ecs/EntityManager.h>
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <set>
+#include <tuple>
 #include <utility>
 
 #include <nox/util/nox_assert.h>
@@ -231,8 +233,9 @@ namespace
         
                 }
         
-                //Removes components if there are too many to fit nicely into the threadpool
-                const std::size_t overshot = executionOrder.back().size() % threadCount;  
+                //Removes components if there are too many to fit nicely into the threadpool.
+                //The thread calling step takes part in the work, so there is always at least one.
+                const std::size_t overshot = executionOrder.back().size() % (threadCount + 1);
                 if (overshot != executionOrder.back().size())
                 {
                     for (std::size_t i = 0; i < overshot; ++i)
@@ -264,8 +267,32 @@ namespace
     }
 }
 
+constexpr std::uint32_t nox::ecs::EntityManager::SNAPSHOT_MAGIC;
+constexpr std::uint32_t nox::ecs::EntityManager::SNAPSHOT_VERSION;
+
+nox::ecs::EntityManager::EntityManager()
+    : ownedThreads(std::make_unique<ThreadPool>())
+    , threads(ownedThreads.get())
+{
+}
+
+nox::ecs::EntityManager::EntityManager(std::size_t threadCount,
+                                       const std::vector<std::size_t>& cpuAffinity)
+    : ownedThreads(std::make_unique<ThreadPool>(threadCount, cpuAffinity))
+    , threads(ownedThreads.get())
+{
+}
+
+nox::ecs::EntityManager::EntityManager(nox::thread::Executor& executor)
+    : threads(&executor)
+{
+}
+
 nox::ecs::EntityManager::~EntityManager()
 {
+    // The cleanup is not a request, and the recorder might already be gone.
+    this->traceRecorder = nullptr;
+
     const auto maxId = this->currentEntityId.load(std::memory_order_acquire);
     for (std::size_t i = 0; i < maxId; ++i)
     {
@@ -280,13 +307,32 @@ nox::ecs::EntityManager::~EntityManager()
 void
 nox::ecs::EntityManager::createEntityDefinition(const Json::Value& root)
 {
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordDefinition(root);
+    }
     this->factory.createEntityDefinition(root);
 }
 
+bool
+nox::ecs::EntityManager::compileEntityDefinitions(std::ostream& stream)
+{
+    return this->factory.compileDefinitions(stream);
+}
+
+bool
+nox::ecs::EntityManager::loadCompiledEntityDefinitions(const std::string& path)
+{
+    return this->factory.loadCompiledDefinitions(path);
+}
+
 void
 nox::ecs::EntityManager::registerComponent(const MetaInformation& info)
 {
+    this->collectionIndices[info.typeIdentifier.getValue()] = this->components.size();
     this->components.push_back(info);
+    this->components.back().setChangeTick(this->changeTick);
 }
 
 void
@@ -310,7 +356,7 @@ nox::ecs::EntityManager::configureComponents()
         };
 
         this->updateExecutionLayers = local::createExecutionLayers(this->components,
-                                                                   this->threads.threadCount(),
+                                                                   this->threads->threadCount(),
                                                                    getDependencies,
                                                                    getDataAccess,
                                                                    shouldBeExecuted);
@@ -335,7 +381,7 @@ nox::ecs::EntityManager::configureComponents()
         };
 
         this->logicEventExecutionLayers = local::createExecutionLayers(this->components,
-                                                                       this->threads.threadCount(),
+                                                                       this->threads->threadCount(),
                                                                        getDependencies,
                                                                        getDataAccess,
                                                                        shouldBeExecuted);
@@ -359,7 +405,7 @@ nox::ecs::EntityManager::configureComponents()
         };
 
         this->entityEventExecutionLayers = local::createExecutionLayers(this->components,
-                                                                        this->threads.threadCount(),
+                                                                        this->threads->threadCount(),
                                                                         getDependencies,
                                                                         getDataAccess,
                                                                         shouldBeExecuted);
@@ -370,22 +416,52 @@ nox::ecs::EntityManager::configureComponents()
 nox::ecs::EntityId
 nox::ecs::EntityManager::createEntity()
 {
+    TraceRecorder::Scope trace(this->traceRecorder);
     const auto newId = this->currentEntityId.fetch_add(EntityId(1), std::memory_order_acq_rel);
+    if (trace)
+    {
+        trace->recordEntity(TraceRecorder::Record::CREATE_ENTITY, newId);
+    }
     return newId;
 }
 
 nox::ecs::EntityId
 nox::ecs::EntityManager::createEntity(const std::string& definitionName)
 {
+    // The requests made by the factory are reproduced by replaying this one.
+    TraceRecorder::Scope trace(this->traceRecorder);
     const auto newId = this->currentEntityId.fetch_add(EntityId(1), std::memory_order_acq_rel);
     this->factory.createEntity(newId, definitionName);
+    if (trace)
+    {
+        trace->recordEntity(newId, definitionName);
+    }
     return newId;
 }
 
+nox::ecs::EntityId
+nox::ecs::EntityManager::createEntities(const std::string& definitionName,
+                                        std::size_t count)
+{
+    TraceRecorder::Scope trace(this->traceRecorder);
+    const auto firstId = this->currentEntityId.fetch_add(EntityId(count), std::memory_order_acq_rel);
+    this->factory.createEntities(firstId, count, definitionName);
+    if (trace)
+    {
+        trace->recordEntities(firstId, count, definitionName);
+    }
+    return firstId;
+}
+
 void
 nox::ecs::EntityManager::assignComponent(const EntityId& id,
                                          const TypeIdentifier& identifier)
 {
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordComponent(TraceRecorder::Record::ASSIGN_COMPONENT, id, identifier);
+    }
     CreationArguments tmp{ id, identifier };
     this->creationRequests.push(std::move(tmp));
 }
@@ -395,8 +471,127 @@ nox::ecs::EntityManager::assignComponent(const EntityId& id,
                                          const TypeIdentifier& identifier,
                                          const Json::Value& value)
 {
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordComponent(id, identifier, value);
+    }
+    CreationArguments tmp{ id, identifier };
+    tmp.kind = CreationArguments::Kind::JSON;
+    this->addCreationPayload(&CreationPayloads::json, value, tmp);
+    this->creationRequests.push(std::move(tmp));
+}
+
+void
+nox::ecs::EntityManager::assignComponent(const EntityId& id,
+                                         const TypeIdentifier& identifier,
+                                         const Json::Value& value,
+                                         const Component* prototype)
+{
+    NOX_ASSERT(prototype, "Assigning component from a nullptr prototype!\n");
+
+    // Replaying the json gives the same component as the clone.
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordComponent(id, identifier, value);
+    }
     CreationArguments tmp{ id, identifier };
+    tmp.kind = CreationArguments::Kind::PROTOTYPE;
+    tmp.prototype = prototype;
+    this->creationRequests.push(std::move(tmp));
+}
+
+const nox::ecs::Component*
+nox::ecs::EntityManager::createPrototype(const TypeIdentifier& identifier,
+                                         const Json::Value& value)
+{
+    const auto index = this->collectionIndices.find(identifier.getValue());
+    if (index == std::end(this->collectionIndices))
+    {
+        return nullptr;
+    }
+
+    return this->components[index->second].createPrototype(value, this);
+}
+
+const nox::ecs::MetaInformation*
+nox::ecs::EntityManager::findMetaInformation(const TypeIdentifier& identifier) const
+{
+    const auto index = this->collectionIndices.find(identifier.getValue());
+    if (index == std::cend(this->collectionIndices))
+    {
+        return nullptr;
+    }
+
+    return &this->components[index->second].getMetaInformation();
+}
+
+void
+nox::ecs::EntityManager::assignComponents(const EntityId& firstId,
+                                          std::size_t count,
+                                          const TypeIdentifier& identifier,
+                                          const Json::Value& value)
+{
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            trace->recordComponent(firstId + i, identifier, value);
+        }
+    }
+    CreationArguments tmp{ firstId, identifier };
+    tmp.kind = CreationArguments::Kind::JSON;
+    this->addCreationPayload(&CreationPayloads::json, value, tmp);
+    tmp.count = count;
+    this->creationRequests.push(std::move(tmp));
+}
+
+void
+nox::ecs::EntityManager::assignComponents(const EntityId& firstId,
+                                          std::size_t count,
+                                          const TypeIdentifier& identifier,
+                                          const Json::Value* value)
+{
+    NOX_ASSERT(value, "Assigning components from a nullptr json value!\n");
+
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            trace->recordComponent(firstId + i, identifier, *value);
+        }
+    }
+    CreationArguments tmp{ firstId, identifier };
+    tmp.kind = CreationArguments::Kind::JSON_REFERENCE;
     tmp.json = value;
+    tmp.count = count;
+    this->creationRequests.push(std::move(tmp));
+}
+
+void
+nox::ecs::EntityManager::assignComponents(const EntityId& firstId,
+                                          std::size_t count,
+                                          const TypeIdentifier& identifier,
+                                          const Json::Value& value,
+                                          const Component* prototype)
+{
+    NOX_ASSERT(prototype, "Assigning components from a nullptr prototype!\n");
+
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            trace->recordComponent(firstId + i, identifier, value);
+        }
+    }
+    CreationArguments tmp{ firstId, identifier };
+    tmp.kind = CreationArguments::Kind::PROTOTYPE;
+    tmp.prototype = prototype;
+    tmp.count = count;
     this->creationRequests.push(std::move(tmp));
 }
 
@@ -405,8 +600,14 @@ nox::ecs::EntityManager::assignComponent(const EntityId& id,
                                          const TypeIdentifier& identifier,
                                          Children&& children)
 {
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordComponent(id, identifier, children);
+    }
     CreationArguments tmp{ id, identifier };
-    tmp.children = std::move(children);
+    tmp.kind = CreationArguments::Kind::CHILDREN;
+    this->addCreationPayload(&CreationPayloads::children, std::move(children), tmp);
     this->creationRequests.push(std::move(tmp));
 }
 
@@ -415,8 +616,14 @@ nox::ecs::EntityManager::assignComponent(const EntityId& id,
                                          const TypeIdentifier& identifier,
                                          Parent&& parent)
 {
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordComponent(id, identifier, parent);
+    }
     CreationArguments tmp{ id, identifier };
-    tmp.parent = std::move(parent);
+    tmp.kind = CreationArguments::Kind::PARENT;
+    this->addCreationPayload(&CreationPayloads::parents, std::move(parent), tmp);
     this->creationRequests.push(std::move(tmp));
 }
 
@@ -432,6 +639,11 @@ void
 nox::ecs::EntityManager::removeComponent(const EntityId& id,
                                          const TypeIdentifier& identifier)
 {
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordComponent(TraceRecorder::Record::REMOVE_COMPONENT, id, identifier);
+    }
     this->removalRequests.push({ id, identifier });
 }
 
@@ -439,6 +651,11 @@ void
 nox::ecs::EntityManager::awakeComponent(const EntityId& id,
                                         const TypeIdentifier& identifier)
 {
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordComponent(TraceRecorder::Record::AWAKE_COMPONENT, id, identifier);
+    }
     this->transitionRequests[Transition::AWAKE].push({ id, identifier });
 }
 
@@ -446,6 +663,11 @@ void
 nox::ecs::EntityManager::activateComponent(const EntityId& id,
                                            const TypeIdentifier& identifier)
 {
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordComponent(TraceRecorder::Record::ACTIVATE_COMPONENT, id, identifier);
+    }
     this->transitionRequests[Transition::ACTIVATE].push({ id, identifier });
 }
 
@@ -453,6 +675,11 @@ void
 nox::ecs::EntityManager::deactivateComponent(const EntityId& id,
                                              const TypeIdentifier& identifier)
 {
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordComponent(TraceRecorder::Record::DEACTIVATE_COMPONENT, id, identifier);
+    }
     this->transitionRequests[Transition::DEACTIVATE].push({ id, identifier });
 }
 
@@ -460,12 +687,22 @@ void
 nox::ecs::EntityManager::hibernateComponent(const EntityId& id, 
                                             const TypeIdentifier& identifier)
 {
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordComponent(TraceRecorder::Record::HIBERNATE_COMPONENT, id, identifier);
+    }
     this->transitionRequests[Transition::HIBERNATE].push({ id, identifier });
 }
 
 void
 nox::ecs::EntityManager::removeEntity(const EntityId& id)
 {
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordEntity(TraceRecorder::Record::REMOVE_ENTITY, id);
+    }
     for (const auto& item : this->components)
     {
         this->removeComponent(id, item.getTypeIdentifier());
@@ -475,6 +712,11 @@ nox::ecs::EntityManager::removeEntity(const EntityId& id)
 void
 nox::ecs::EntityManager::awakeEntity(const EntityId& id)
 {
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordEntity(TraceRecorder::Record::AWAKE_ENTITY, id);
+    }
     for (const auto& item : this->components)
     {
         this->awakeComponent(id, item.getTypeIdentifier());
@@ -484,6 +726,11 @@ nox::ecs::EntityManager::awakeEntity(const EntityId& id)
 void
 nox::ecs::EntityManager::activateEntity(const EntityId& id)
 {
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordEntity(TraceRecorder::Record::ACTIVATE_ENTITY, id);
+    }
     for (const auto& item : this->components)
     {
         this->activateComponent(id, item.getTypeIdentifier());
@@ -493,6 +740,11 @@ nox::ecs::EntityManager::activateEntity(const EntityId& id)
 void
 nox::ecs::EntityManager::deactivateEntity(const EntityId& id)
 {
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordEntity(TraceRecorder::Record::DEACTIVATE_ENTITY, id);
+    }
     for (const auto& item : this->components)
     {
         this->deactivateComponent(id, item.getTypeIdentifier());
@@ -502,6 +754,11 @@ nox::ecs::EntityManager::deactivateEntity(const EntityId& id)
 void
 nox::ecs::EntityManager::hibernateEntity(const EntityId& id)
 {
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordEntity(TraceRecorder::Record::HIBERNATE_ENTITY, id);
+    }
     for (const auto& item : this->components)
     {
         this->hibernateComponent(id, item.getTypeIdentifier());
@@ -511,6 +768,12 @@ nox::ecs::EntityManager::hibernateEntity(const EntityId& id)
 void
 nox::ecs::EntityManager::step(const nox::Duration& deltaTime)
 {
+    TraceRecorder::Scope trace(this->traceRecorder, true);
+    if (trace)
+    {
+        trace->recordStep(TraceRecorder::Record::STEP, deltaTime);
+    }
+    this->advanceChangeTick();
     this->distributeLogicEvents();
     this->updateStep(deltaTime);
     this->distributeEntityEvents();
@@ -522,21 +785,58 @@ nox::ecs::EntityManager::step(const nox::Duration& deltaTime)
     this->activateStep();
 }
 
+void
+nox::ecs::EntityManager::advanceChangeTick()
+{
+    TraceRecorder::Scope trace(this->traceRecorder, true);
+    if (trace)
+    {
+        trace->recordStep(TraceRecorder::Record::ADVANCE_CHANGE_TICK);
+    }
+    ++this->changeTick;
+    for (auto& collection : this->components)
+    {
+        collection.setChangeTick(this->changeTick);
+    }
+}
+
+nox::ecs::ComponentCollection::ChangeTick
+nox::ecs::EntityManager::getChangeTick() const
+{
+    return this->changeTick;
+}
+
+void
+nox::ecs::EntityManager::markComponentChanged(const EntityId& id,
+                                              const TypeIdentifier& identifier)
+{
+    this->getCollection(identifier).markChanged(id);
+}
+
+void
+nox::ecs::EntityManager::markComponentChanged(const Component* component,
+                                              const TypeIdentifier& identifier)
+{
+    this->getCollection(identifier).markChanged(component);
+}
+
 void
 nox::ecs::EntityManager::distributeLogicEvents()
 {
+    TraceRecorder::Scope trace(this->traceRecorder, true);
+    if (trace)
+    {
+        trace->recordStep(TraceRecorder::Record::DISTRIBUTE_LOGIC_EVENTS);
+    }
     std::shared_ptr<nox::event::Event> event{};
     while (this->logicEvents.pop(event))
     {
         #ifdef NOX_ECS_LAYERED_EXECUTION_LOGIC_EVENTS
             for (const auto& layer : this->logicEventExecutionLayers)
             {
-                for (const auto& item : layer)
-                {
-                    this->threads.addTask([this, item, &event]()
-                                          { this->components[item].receiveLogicEvent(event); });
-                }
-                this->threads.wait();
+                this->executeLayer(layer,
+                                   [this, &event](std::size_t item)
+                                   { this->components[item].receiveLogicEvent(event); });
             }
         #else
             for (auto& item : this->components)
@@ -551,15 +851,17 @@ nox::ecs::EntityManager::distributeLogicEvents()
 void
 nox::ecs::EntityManager::updateStep(const nox::Duration& deltaTime)
 {
+    TraceRecorder::Scope trace(this->traceRecorder, true);
+    if (trace)
+    {
+        trace->recordStep(TraceRecorder::Record::UPDATE_STEP, deltaTime);
+    }
     #ifdef NOX_ECS_LAYERED_EXECUTION_UPDATE
         for (const auto& layer : this->updateExecutionLayers)
         {
-            for (const auto& item : layer)
-            {
-                this->threads.addTask([this, item, deltaTime]()
-                                      { this->components[item].update(deltaTime); });
-            }
-            this->threads.wait();
+            this->executeLayer(layer,
+                               [this, &deltaTime](std::size_t item)
+                               { this->components[item].update(deltaTime); });
         }
     #else
         for (auto& item : this->components)
@@ -572,39 +874,113 @@ nox::ecs::EntityManager::updateStep(const nox::Duration& deltaTime)
 void
 nox::ecs::EntityManager::distributeEntityEvents()
 {
-    // Hack, done to ensure that event is destroyed
-    // before the eventArgumentAllocator is cleared.
+    TraceRecorder::Scope trace(this->traceRecorder, true);
+    if (trace)
     {
-        // Temp event, only needed for the popping.
-        Event event(&eventArgumentAllocator, {0}, 0, 0);
-        while (this->entityEvents.pop(event))
+        trace->recordStep(TraceRecorder::Record::DISTRIBUTE_ENTITY_EVENTS);
+    }
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
+    std::size_t waveCount = 0;
+
+    // Temp event, only needed for the popping. Never holds arguments
+    // after being moved from, so it can outlive the wave allocators.
+    Event event(nullptr, {0}, 0, 0);
+
+    while (waveCount < this->entityEventWaveLimit &&
+           std::chrono::duration_cast<nox::Duration>(Clock::now() - start) < this->entityEventTimeBudget)
+    {
+        // Swap buffers so events sent during this wave ends up in the next one.
+        const auto current = this->entityEventBuffer.load(std::memory_order_acquire);
+        this->entityEventBuffer.store(current ^ 1, std::memory_order_release);
+
+        auto& waveEvents = this->entityEvents[current];
+        while (waveEvents.pop(event))
         {
-        #ifdef NOX_ECS_LAYERED_EXECUTION_ENTITY_EVENTS
-            for (const auto& layer : this->entityEventExecutionLayers)
-            {
-                for (const auto& item : layer)
-                {
-                    this->threads.addTask([this, item, &event]()
-                                          { this->components[item].receiveEntityEvent(event); });
-                }
-                this->threads.wait();
-            }
-        #else
-            for (auto& item : this->components)
+            this->entityEventWave.push_back(std::move(event));
+        }
+        waveEvents.clear();
+
+        if (this->entityEventWave.empty())
+        {
+            break;
+        }
+
+        // The stack gives us the events in reverse, restore the order they were sent in.
+        std::reverse(std::begin(this->entityEventWave),
+                     std::end(this->entityEventWave));
+
+        this->coalesceEntityEventWave();
+
+    #ifdef NOX_ECS_LAYERED_EXECUTION_ENTITY_EVENTS
+        for (const auto& layer : this->entityEventExecutionLayers)
+        {
+            this->executeLayer(layer,
+                               [this](std::size_t item)
+                               {
+                                   for (const auto& waveEvent : this->entityEventWave)
+                                   {
+                                       this->components[item].receiveEntityEvent(waveEvent);
+                                   }
+                               });
+        }
+    #else
+        for (auto& item : this->components)
+        {
+            for (const auto& waveEvent : this->entityEventWave)
             {
-                item.receiveEntityEvent(event);
+                item.receiveEntityEvent(waveEvent);
             }
-        #endif
         }
+    #endif
+
+        this->entityEventWave.clear();
+
+        // Every event of the wave is destroyed, so its arguments can go.
+        this->eventArgumentAllocators[current].clear();
+        ++waveCount;
     }
+}
+
+void
+nox::ecs::EntityManager::setEntityEventWaveLimit(std::size_t waveLimit)
+{
+    NOX_ASSERT(waveLimit > 0, "Wave limit must be > 0, was: %zu", waveLimit);
+    this->entityEventWaveLimit = waveLimit;
+}
+
+void
+nox::ecs::EntityManager::setEntityEventTimeBudget(const nox::Duration& budget)
+{
+    this->entityEventTimeBudget = budget;
+}
 
-    this->entityEvents.clear();
-    this->eventArgumentAllocator.clear();
+void
+nox::ecs::EntityManager::setEntityEventCoalescing(const TypeIdentifier& eventType, bool coalesce)
+{
+    auto& types = this->coalescedEntityEventTypes;
+    const auto itr = std::lower_bound(std::begin(types), std::end(types), eventType.getValue());
+    const bool isCoalesced = itr != std::end(types) && *itr == eventType.getValue();
+
+    if (coalesce && !isCoalesced)
+    {
+        types.insert(itr, eventType.getValue());
+    }
+    else if (!coalesce && isCoalesced)
+    {
+        types.erase(itr);
+    }
 }
 
 void
 nox::ecs::EntityManager::deactivateStep()
 {
+    TraceRecorder::Scope trace(this->traceRecorder, true);
+    if (trace)
+    {
+        trace->recordStep(TraceRecorder::Record::DEACTIVATE_STEP);
+    }
     ComponentIdentifier identifier;
     while (this->transitionRequests[Transition::DEACTIVATE].pop(identifier))
     {
@@ -617,6 +993,11 @@ nox::ecs::EntityManager::deactivateStep()
 void
 nox::ecs::EntityManager::hibernateStep()
 {
+    TraceRecorder::Scope trace(this->traceRecorder, true);
+    if (trace)
+    {
+        trace->recordStep(TraceRecorder::Record::HIBERNATE_STEP);
+    }
     ComponentIdentifier identifier;
     while (this->transitionRequests[Transition::HIBERNATE].pop(identifier))
     {
@@ -629,6 +1010,11 @@ nox::ecs::EntityManager::hibernateStep()
 void
 nox::ecs::EntityManager::removeStep()
 {
+    TraceRecorder::Scope trace(this->traceRecorder, true);
+    if (trace)
+    {
+        trace->recordStep(TraceRecorder::Record::REMOVE_STEP);
+    }
     ComponentIdentifier identifier;
     while (this->removalRequests.pop(identifier))
     {
@@ -641,38 +1027,77 @@ nox::ecs::EntityManager::removeStep()
 void
 nox::ecs::EntityManager::createStep()
 {
+    TraceRecorder::Scope trace(this->traceRecorder, true);
+    if (trace)
+    {
+        trace->recordStep(TraceRecorder::Record::CREATE_STEP);
+    }
     CreationArguments identifier;
     while (this->creationRequests.pop(identifier))
     {
         auto& collection = this->getCollection(identifier.type);
 
-        if (identifier.type == ecs::component_type::CHILDREN)
-        {
-            Children& child = identifier.children;
-            collection.adopt(child);
-        } 
-        else if (identifier.type == ecs::component_type::PARENT)
-        {
-            Parent& parent = identifier.parent;
-            collection.adopt(parent);
-        }
-        else
+        // Nothing else runs during createStep, so the payloads are read without locking.
+        auto& payloads = this->creationPayloads[identifier.payloadTable];
+        switch (identifier.kind)
         {
-            collection.create(identifier.id, this);
-            const Json::Value& jsonValue = identifier.json;
+            case CreationArguments::Kind::CHILDREN:
+                collection.adopt(payloads.children[identifier.payload]);
+                break;
 
-            if (!jsonValue.isNull())
+            case CreationArguments::Kind::PARENT:
+                collection.adopt(payloads.parents[identifier.payload]);
+                break;
+
+            case CreationArguments::Kind::PROTOTYPE:
+                collection.clone(identifier.id, identifier.count, this, *identifier.prototype);
+                break;
+
+            case CreationArguments::Kind::JSON:
+            case CreationArguments::Kind::JSON_REFERENCE:
+            case CreationArguments::Kind::DEFAULT:
             {
-                collection.initialize(identifier.id, jsonValue);
+                const Json::Value* jsonValue = nullptr;
+                if (identifier.kind == CreationArguments::Kind::JSON)
+                {
+                    jsonValue = &payloads.json[identifier.payload];
+                }
+                else if (identifier.kind == CreationArguments::Kind::JSON_REFERENCE)
+                {
+                    jsonValue = identifier.json;
+                }
+
+                for (std::size_t i = 0; i < identifier.count; ++i)
+                {
+                    collection.create(identifier.id + i, this);
+
+                    if (jsonValue && !jsonValue->isNull())
+                    {
+                        collection.initialize(identifier.id + i, *jsonValue);
+                    }
+                }
+                break;
             }
         }
     }
     this->creationRequests.clear();
+
+    for (auto& payloads : this->creationPayloads)
+    {
+        payloads.json.clear();
+        payloads.children.clear();
+        payloads.parents.clear();
+    }
 }
 
 void
 nox::ecs::EntityManager::awakeStep()
 {
+    TraceRecorder::Scope trace(this->traceRecorder, true);
+    if (trace)
+    {
+        trace->recordStep(TraceRecorder::Record::AWAKE_STEP);
+    }
     ComponentIdentifier identifier;
     while (this->transitionRequests[Transition::AWAKE].pop(identifier))
     {
@@ -685,6 +1110,11 @@ nox::ecs::EntityManager::awakeStep()
 void
 nox::ecs::EntityManager::activateStep()
 {
+    TraceRecorder::Scope trace(this->traceRecorder, true);
+    if (trace)
+    {
+        trace->recordStep(TraceRecorder::Record::ACTIVATE_STEP);
+    }
     ComponentIdentifier identifier;
     while (this->transitionRequests[Transition::ACTIVATE].pop(identifier))
     {
@@ -699,7 +1129,9 @@ nox::ecs::EntityManager::createEntityEvent(const TypeIdentifier& eventType,
                                            const EntityId& senderId,
                                            const EntityId& receiverId)
 {
-    return std::move(Event(&eventArgumentAllocator,
+    // Arguments live as long as the buffer the event is sent to.
+    const auto current = this->entityEventBuffer.load(std::memory_order_acquire);
+    return std::move(Event(&this->eventArgumentAllocators[current],
                            eventType,
                            senderId,
                            receiverId));
@@ -708,7 +1140,13 @@ nox::ecs::EntityManager::createEntityEvent(const TypeIdentifier& eventType,
 void
 nox::ecs::EntityManager::sendEntityEvent(ecs::Event event)
 {
-    this->entityEvents.push(std::move(event));
+    TraceRecorder::Scope trace(this->traceRecorder);
+    if (trace)
+    {
+        trace->recordEvent(event);
+    }
+    const auto current = this->entityEventBuffer.load(std::memory_order_acquire);
+    this->entityEvents[current].push(std::move(event));
 }
 
 void
@@ -720,13 +1158,204 @@ nox::ecs::EntityManager::onEvent(const std::shared_ptr<nox::event::Event>& event
 nox::ecs::ComponentCollection&
 nox::ecs::EntityManager::getCollection(const TypeIdentifier& identifier)
 {
-    auto collection = std::find_if(std::begin(this->components),
-                                   std::end(this->components),
-                                   [&identifier](const auto& item)
-                                   { return item.getTypeIdentifier() == identifier; });
-    NOX_ASSERT(collection != std::end(this->components), "Illegal identifier, collection not found!\n");
+    const auto index = this->collectionIndices.find(identifier.getValue());
+    NOX_ASSERT(index != std::end(this->collectionIndices), "Illegal identifier, collection not found!\n");
+
+    return this->components[index->second];
+}
+
+template<class Function>
+void
+nox::ecs::EntityManager::executeLayer(const std::vector<std::size_t>& layer, const Function& function)
+{
+    this->layerTasks.clear();
+    for (const auto& item : layer)
+    {
+        this->layerTasks.emplace_back([&function, item]() { function(item); });
+    }
+
+    nox::thread::TaskGroup group{};
+    this->threads->addTasks(this->layerTasks.data(),
+                            this->layerTasks.data() + this->layerTasks.size(),
+                            group);
+    this->threads->wait(group);
+}
+
+void
+nox::ecs::EntityManager::coalesceEntityEventWave()
+{
+    if (this->coalescedEntityEventTypes.empty())
+    {
+        return;
+    }
+
+    auto& events = this->coalescedEvents;
+    events.clear();
+    for (std::size_t i = 0; i < this->entityEventWave.size(); ++i)
+    {
+        const auto& event = this->entityEventWave[i];
+        if (std::binary_search(std::begin(this->coalescedEntityEventTypes),
+                               std::end(this->coalescedEntityEventTypes),
+                               event.getType().getValue()))
+        {
+            events.push_back({event.getType().getValue(), event.getSender(), event.getReceiver(), i});
+        }
+    }
+
+    if (events.size() < 2)
+    {
+        return;
+    }
+
+    const auto sameKey = [](const CoalescedEvent& lhs, const CoalescedEvent& rhs)
+    {
+        return lhs.type == rhs.type && lhs.sender == rhs.sender && lhs.receiver == rhs.receiver;
+    };
+
+    std::sort(std::begin(events), std::end(events),
+              [](const CoalescedEvent& lhs, const CoalescedEvent& rhs)
+              {
+                  return std::tie(lhs.type, lhs.sender, lhs.receiver, lhs.index) <
+                         std::tie(rhs.type, rhs.sender, rhs.receiver, rhs.index);
+              });
+
+    // Keep only the events to drop, i.e. every event followed by one with the same key.
+    std::size_t dropCount = 0;
+    for (std::size_t i = 0; i + 1 < events.size(); ++i)
+    {
+        if (sameKey(events[i], events[i + 1]))
+        {
+            events[dropCount++] = events[i];
+        }
+    }
+
+    if (dropCount == 0)
+    {
+        return;
+    }
+
+    events.resize(dropCount);
+    std::sort(std::begin(events), std::end(events),
+              [](const CoalescedEvent& lhs, const CoalescedEvent& rhs)
+              { return lhs.index < rhs.index; });
+
+    // Dropped events are destroyed as they are overwritten or erased.
+    std::size_t write = 0;
+    std::size_t drop = 0;
+    for (std::size_t read = 0; read < this->entityEventWave.size(); ++read)
+    {
+        if (drop < events.size() && events[drop].index == read)
+        {
+            ++drop;
+            continue;
+        }
+
+        if (write != read)
+        {
+            this->entityEventWave[write] = std::move(this->entityEventWave[read]);
+        }
+        ++write;
+    }
+
+    this->entityEventWave.erase(std::begin(this->entityEventWave) + write,
+                                std::end(this->entityEventWave));
+}
+
+void
+nox::ecs::EntityManager::setTraceRecorder(TraceRecorder* recorder)
+{
+    this->traceRecorder = recorder;
+}
+
+bool
+nox::ecs::EntityManager::saveSnapshot(std::ostream& stream) const
+{
+    const auto serializable = std::all_of(std::cbegin(this->components),
+                                          std::cend(this->components),
+                                          [](const auto& item)
+                                          { return item.isSerializable(); });
+    if (!serializable)
+    {
+        return false;
+    }
+
+    // Empty collections are left out, so the loading side does not need their types registered.
+    const auto collectionCount = std::count_if(std::cbegin(this->components),
+                                               std::cend(this->components),
+                                               [](const auto& item)
+                                               { return item.count() != 0; });
+
+    const std::uint32_t header[] = { SNAPSHOT_MAGIC, SNAPSHOT_VERSION };
+    const std::uint64_t state[] = { this->currentEntityId.load(std::memory_order_acquire),
+                                    this->changeTick,
+                                    static_cast<std::uint64_t>(collectionCount) };
+    stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+    stream.write(reinterpret_cast<const char*>(state), sizeof(state));
+
+    for (const auto& collection : this->components)
+    {
+        if (collection.count() == 0)
+        {
+            continue;
+        }
+
+        const std::uint64_t identifier = collection.getTypeIdentifier().getValue();
+        stream.write(reinterpret_cast<const char*>(&identifier), sizeof(identifier));
+        if (!collection.writeSnapshot(stream))
+        {
+            return false;
+        }
+    }
+
+    return stream.good();
+}
+
+bool
+nox::ecs::EntityManager::loadSnapshot(std::istream& stream)
+{
+    // Reading into a populated collection would overwrite its storage and index.
+    const auto empty = std::all_of(std::cbegin(this->components),
+                                   std::cend(this->components),
+                                   [](const auto& item)
+                                   { return item.count() == 0; });
+    if (!empty)
+    {
+        return false;
+    }
+
+    std::uint32_t header[2] = {};
+    std::uint64_t state[3] = {};
+    stream.read(reinterpret_cast<char*>(header), sizeof(header));
+    stream.read(reinterpret_cast<char*>(state), sizeof(state));
+    if (!stream || header[0] != SNAPSHOT_MAGIC || header[1] != SNAPSHOT_VERSION)
+    {
+        return false;
+    }
+
+    for (std::uint64_t i = 0; i < state[2]; ++i)
+    {
+        std::uint64_t identifier = 0;
+        if (!stream.read(reinterpret_cast<char*>(&identifier), sizeof(identifier)))
+        {
+            return false;
+        }
+
+        const auto index = this->collectionIndices.find(static_cast<std::size_t>(identifier));
+        if (index == std::end(this->collectionIndices) ||
+            !this->components[index->second].readSnapshot(stream, this))
+        {
+            return false;
+        }
+    }
+
+    const auto nextId = static_cast<EntityId>(state[0]);
+    if (this->currentEntityId.load(std::memory_order_acquire) < nextId)
+    {
+        this->currentEntityId.store(nextId, std::memory_order_release);
+    }
+    this->changeTick = std::max(this->changeTick, static_cast<ComponentCollection::ChangeTick>(state[1]));
 
-    return *collection;
+    return true;
 }
 
 void
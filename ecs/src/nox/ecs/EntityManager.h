@@ -2,8 +2,16 @@
 #define NOX_ECS_ENTITYMANAGER_H_
 #include <array>
 #include <atomic>
-#include <deque>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
 #include <queue>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 #include <nox/ecs/component/Children.h>
@@ -11,15 +19,21 @@
 #include <nox/ecs/ComponentCollection.h>
 #include <nox/ecs/EntityId.h>
 #include <nox/ecs/Event.h>
+#include <nox/ecs/EventType.h>
 #include <nox/ecs/Factory.h>
 #include <nox/ecs/MetaInformation.h>
 #include <nox/ecs/SmartHandle.h>
+#include <nox/ecs/TraceRecorder.h>
 #include <nox/ecs/TypeIdentifier.h>
 #include <nox/event/IListener.h>
 #include <nox/logic/Logic.h>
+#include <nox/thread/Executor.h>
 #include <nox/thread/LockedQueue.h>
 #include <nox/thread/LockFreeStack.h>
+#include <nox/thread/parallelFor.h>
+#include <nox/thread/ThreadIndex.h>
 #include <nox/thread/Pool.h>
+#include <nox/thread/WorkStealingPool.h>
 #include <nox/util/nox_assert.h>
 
 #include <json/json.h>
@@ -68,12 +82,54 @@ namespace nox
          *             NOX_ECS_LAYERED_EXECUTION_LOGIC_EVENTS
          *             Defining this macro will turn on layered execution
          *             for the distributeLogicEvents function.
+         *
+         *             NOX_ECS_WORK_STEALING_POOL
+         *             Defining this macro will run the layered execution
+         *             on a nox::thread::WorkStealingPool rather than the
+         *             regular nox::thread::Pool.
+         *
+         *             By default the EntityManager owns a pool with one
+         *             thread less than the hardware supports. The thread
+         *             count and CPU affinity of the pool can be given to the
+         *             constructor, or the layered execution can be run on a
+         *             nox::thread::Executor owned by the application, which
+         *             lets several EntityManagers share the same threads.
          */
         class EntityManager final
             : public nox::event::IListener
         {
         public:
-            EntityManager() = default;
+            /**
+             * @brief      Creates an EntityManager owning a thread pool with
+             *             the default number of threads.
+             */
+            EntityManager();
+
+            /**
+             * @brief      Creates an EntityManager owning a thread pool with
+             *             the given number of threads.
+             *
+             * @param[in]  threadCount  The number of threads in the pool, the
+             *                          thread calling step also takes part
+             *                          in the work.
+             * @param[in]  cpuAffinity  The CPUs to pin the threads to, thread
+             *                          i is pinned to cpuAffinity[i % size].
+             *                          Empty leaves the threads unpinned.
+             */
+            explicit EntityManager(std::size_t threadCount,
+                                   const std::vector<std::size_t>& cpuAffinity = {});
+
+            /**
+             * @brief      Creates an EntityManager running its layered
+             *             execution on executor, rather than on threads of
+             *             its own.
+             *
+             * @param      executor  The executor to run the work on, must
+             *                       outlive the EntityManager. Can be shared
+             *                       between several EntityManagers.
+             */
+            explicit EntityManager(nox::thread::Executor& executor);
+
             EntityManager(const EntityManager&) = delete;
             EntityManager& operator=(const EntityManager&) = delete;
             EntityManager(EntityManager&&) = delete;
@@ -93,6 +149,37 @@ namespace nox
             void
             createEntityDefinition(const Json::Value& root);
 
+            /**
+             * @brief      Compiles all entity definitions created so far into
+             *             the binary prefab format, see
+             *             Factory::compileDefinitions. Meant to be run
+             *             offline, with the same components registered and
+             *             configured as the game that loads the result.
+             *
+             * @param      stream  The stream to write to, must be opened in
+             *                     binary mode.
+             *
+             * @return     true if everything was written.
+             */
+            bool
+            compileEntityDefinitions(std::ostream& stream);
+
+            /**
+             * @brief      Loads entity definitions compiled by
+             *             compileEntityDefinitions, see
+             *             Factory::loadCompiledDefinitions. The load is not
+             *             recorded by the TraceRecorder, so the file must be
+             *             loaded again before replaying a trace.
+             *
+             * @param[in]  path  The path of the compiled file.
+             *
+             * @return     true if the file was loaded, false if it could not
+             *             be mapped, or does not match the registered
+             *             components.
+             */
+            bool
+            loadCompiledEntityDefinitions(const std::string& path);
+
             /**
              * @brief      Informs the EntityManager that a certain component
              *             type exists. All components types that one wants to
@@ -138,6 +225,27 @@ namespace nox
             EntityId
             createEntity(const std::string& definitionName);
 
+            /**
+             * @brief      Creates count new EntityIds in a contiguous range,
+             *             and assigns the components needed based on the json
+             *             definition. One creation request is made per
+             *             component type, rather than per entity.
+             *
+             * @note       Component creation is an async operation, the actual
+             *             creation of the components will not happen until the
+             *             createStep function is run
+             *
+             * @param[in]  definitionName  The name of the definition to create
+             *                             the entities from.
+             * @param[in]  count           The number of entities to create.
+             *
+             * @return     The first EntityId of the range [first, first +
+             *             count).
+             */
+            EntityId
+            createEntities(const std::string& definitionName,
+                           std::size_t count);
+
             /**
              * @brief      Creates and assigns a component to the entity
              *             identified with the id.
@@ -177,6 +285,145 @@ namespace nox
                             const TypeIdentifier& identifier,
                             const Json::Value& value);
 
+            /**
+             * @brief      Creates and assigns a component to the entity
+             *             identified with the id. The component is cloned from
+             *             the prototype rather than initialized with the json
+             *             value, which is only kept for recording.
+             *
+             * @note       Creation is an async operation, the actual creation
+             *             of the component will not happen until the createStep
+             *             function is run.
+             *
+             * @param[in]  id          The id of the entity to assign the
+             *                         component to.
+             * @param[in]  identifier  The type identifier of the component
+             *                         type.
+             * @param[in]  value       json value the prototype was created
+             *                         from.
+             * @param[in]  prototype   The prototype to clone, created from
+             *                         value by createPrototype. Must not be
+             *                         nullptr.
+             */
+            void
+            assignComponent(const EntityId& id,
+                            const TypeIdentifier& identifier,
+                            const Json::Value& value,
+                            const Component* prototype);
+
+            /**
+             * @brief      Creates a prototype of the component type,
+             *             initialized with the json value, which components
+             *             can be cloned from. See MetaInformation::clone.
+             *
+             * @param[in]  identifier  The type identifier of the component
+             *                         type.
+             * @param[in]  value       json value to initialize the prototype
+             *                         with.
+             *
+             * @return     The prototype, which lives as long as the
+             *             EntityManager. nullptr if the component type is not
+             *             registered or has no clone operation.
+             */
+            const Component*
+            createPrototype(const TypeIdentifier& identifier,
+                            const Json::Value& value);
+
+            /**
+             * @brief      Finds the MetaInformation of a registered component
+             *             type.
+             *
+             * @param[in]  identifier  The type identifier of the component
+             *                         type.
+             *
+             * @return     The MetaInformation, nullptr if the component type
+             *             is not registered.
+             */
+            const MetaInformation*
+            findMetaInformation(const TypeIdentifier& identifier) const;
+
+            /**
+             * @brief      Creates and assigns a component to each of the
+             *             entities [firstId, firstId + count), with a single
+             *             creation request. The components are initialized
+             *             with the json value.
+             *
+             * @note       Creation and initialization are async operations,
+             *             the actual creation and initialization of the
+             *             components will not happen until the createStep
+             *             function is run.
+             *
+             * @param[in]  firstId     The id of the first entity to assign
+             *                         the component to.
+             * @param[in]  count       The number of entities.
+             * @param[in]  identifier  The type identifier of the component
+             *                         type.
+             * @param[in]  value       json value containing the value to
+             *                         initialize the components with.
+             */
+            void
+            assignComponents(const EntityId& firstId,
+                             std::size_t count,
+                             const TypeIdentifier& identifier,
+                             const Json::Value& value);
+
+            /**
+             * @brief      Creates and assigns a component to each of the
+             *             entities [firstId, firstId + count), with a single
+             *             creation request. The components are initialized
+             *             with the json value, which is referenced by the
+             *             request rather than copied.
+             *
+             * @note       Creation and initialization are async operations,
+             *             the actual creation and initialization of the
+             *             components will not happen until the createStep
+             *             function is run.
+             *
+             * @param[in]  firstId     The id of the first entity to assign
+             *                         the component to.
+             * @param[in]  count       The number of entities.
+             * @param[in]  identifier  The type identifier of the component
+             *                         type.
+             * @param[in]  value       json value containing the value to
+             *                         initialize the components with. Must
+             *                         not be nullptr, and must stay alive
+             *                         and unchanged until createStep has
+             *                         run, like the json of a definition.
+             */
+            void
+            assignComponents(const EntityId& firstId,
+                             std::size_t count,
+                             const TypeIdentifier& identifier,
+                             const Json::Value* value);
+
+            /**
+             * @brief      Creates and assigns a component to each of the
+             *             entities [firstId, firstId + count), with a single
+             *             creation request. The components are cloned from
+             *             the prototype.
+             *
+             * @note       Creation is an async operation, the actual creation
+             *             of the components will not happen until the
+             *             createStep function is run.
+             *
+             * @param[in]  firstId     The id of the first entity to assign
+             *                         the component to.
+             * @param[in]  count       The number of entities.
+             * @param[in]  identifier  The type identifier of the component
+             *                         type.
+             * @param[in]  value       json value the prototype was created
+             *                         from.
+             * @param[in]  prototype   The prototype to clone, created from
+             *                         value by createPrototype. Must not be
+             *                         nullptr.
+             */
+            void
+            assignComponents(const EntityId& firstId,
+                             std::size_t count,
+                             const TypeIdentifier& identifier,
+                             const Json::Value& value,
+                             const Component* prototype);
+
             /**
              * @brief      Assigns the children component to the entity
              *             identified with the id. The component is moved from
@@ -376,6 +623,7 @@ namespace nox
             /**
              * @brief      Convenience function, going through all the different steps
              *             in the lifecycle in the following manner:
+             *             0. Advance the change tick.
              *             1. Distribute logic events.
              *             2. Update.
              *             3. Distribute component events.
@@ -391,6 +639,74 @@ namespace nox
             void 
             step(const nox::Duration& deltaTime);
 
+            /**
+             * @brief      Advances the change tick components are stamped with
+             *             when marked as changed, done at the start of every
+             *             step. Must not be called concurrently with
+             *             markComponentChanged.
+             */
+            void
+            advanceChangeTick();
+
+            /**
+             * @brief      Returns the current change tick.
+             *
+             * @return     The tick components marked as changed right now are
+             *             stamped with.
+             */
+            ComponentCollection::ChangeTick
+            getChangeTick() const;
+
+            /**
+             * @brief      Marks the component of type identifier belonging to
+             *             the entity identified by id as changed in the current
+             *             change tick. Can be called concurrently for different
+             *             components, e.g. from within update.
+             *
+             * @param[in]  id          The id of the entity the component
+             *                         belongs to.
+             * @param[in]  identifier  The type identifier of the component.
+             */
+            void
+            markComponentChanged(const EntityId& id,
+                                 const TypeIdentifier& identifier);
+
+            /**
+             * @brief      Marks component as changed in the current change
+             *             tick. Cheaper than going through the entity id, as
+             *             the slot of the component is known directly. Can be
+             *             called concurrently for different components, e.g.
+             *             from within update.
+             *
+             * @param[in]  component   The component, must be owned by this
+             *                         EntityManager.
+             * @param[in]  identifier  The type identifier of the component.
+             */
+            void
+            markComponentChanged(const Component* component,
+                                 const TypeIdentifier& identifier);
+
+            /**
+             * @brief      Calls function on every component of type identifier
+             *             marked as changed after the change tick since, or
+             *             created after it. Lets consumers touch only what
+             *             changed, without any events being sent.
+             *
+             * @note       Changes marked during the tick given as since are
+             *             not visited. A consumer looking once per step should
+             *             pass getChangeTick() - 1 from its previous look if
+             *             changes can be marked after it in the same step.
+             *
+             * @param[in]  identifier  The type identifier of the components.
+             * @param[in]  since       The change tick to compare against.
+             * @param[in]  function    Called as function(Component&).
+             */
+            template<class Function>
+            void
+            forEachChangedComponent(const TypeIdentifier& identifier,
+                                    ComponentCollection::ChangeTick since,
+                                    const Function& function);
+
             /**
              * @brief      Goes through all the components interested in the
              *             different events that the EntityManager has received
@@ -411,9 +727,74 @@ namespace nox
             /**
              * @brief      Distributes all the EntityEvents to the designated
              *             entities.
+             *
+             * @detail     Events are distributed in waves. The first wave
+             *             holds all events sent before the function was
+             *             called, events sent while a wave is being
+             *             distributed (i.e. from within receiveEntityEvent)
+             *             are put in the next wave. Each wave is handed to
+             *             the component collections as one batch, in the
+             *             order the events were sent.
+             *
+             *             Distribution stops when a wave is empty, when the
+             *             wave limit is reached, or when the time budget is
+             *             spent. Any events left are deferred to the next
+             *             call.
+             *
+             *             The arguments of a wave are freed as soon as the
+             *             wave is distributed, so the memory held by the
+             *             events is bounded by two waves, even if every call
+             *             is cut short by the limits.
+             *
+             * @see        setEntityEventWaveLimit
+             * @see        setEntityEventTimeBudget
              */
             void
             distributeEntityEvents();
+
+            /**
+             * @brief      Sets the maximum number of waves distributed within
+             *             one call to distributeEntityEvents. Events left after
+             *             the last wave are deferred to the next frame.
+             *
+             * @param[in]  waveLimit  The maximum number of waves per call.
+             *                        Must be > 0. Defaults to no limit.
+             */
+            void
+            setEntityEventWaveLimit(std::size_t waveLimit);
+
+            /**
+             * @brief      Sets the time budget of distributeEntityEvents. The
+             *             budget is checked between waves, so a wave that is
+             *             started is always finished. Events left when the
+             *             budget is spent are deferred to the next frame.
+             *
+             * @param[in]  budget  The time allowed to spend distributing
+             *                     entity events per call. Defaults to no
+             *                     limit.
+             */
+            void
+            setEntityEventTimeBudget(const nox::Duration& budget);
+
+            /**
+             * @brief      Sets whether events of eventType are coalesced.
+             *             Within each wave of distributeEntityEvents, only the
+             *             last coalesced event sent from one sender to one
+             *             receiver is distributed, the earlier ones are
+             *             dropped. Meant for events carrying the full state
+             *             of something, where only the latest matters.
+             *
+             *             event_type::TRANSFORM_CHANGE is coalesced by
+             *             default.
+             *
+             * @warning    Must not be called while entity events are sent or
+             *             distributed.
+             *
+             * @param[in]  eventType  The event type.
+             * @param[in]  coalesce   Whether to coalesce events of eventType.
+             */
+            void
+            setEntityEventCoalescing(const TypeIdentifier& eventType, bool coalesce);
   
             /**
              * @brief      Deactivates all requested components.
@@ -458,7 +839,14 @@ namespace nox
              *
              * @note       Creating events within receiveEvent functions in a
              *             concurrent environment is legal, and the event will
-             *             be parsed in the current frame.
+             *             be parsed in the next wave of the current frame,
+             *             unless the wave limit or time budget of
+             *             distributeEntityEvents is exhausted.
+             *
+             * @warning    The arguments of the event belong to the wave it is
+             *             created in, so it must be sent before the next call
+             *             to distributeEntityEvents, or while distributing
+             *             from within receiveEntityEvent.
              *
              * @see        nox::ecs::Event
              *
@@ -474,6 +862,31 @@ namespace nox
             createEntityEvent(const TypeIdentifier& eventType,
                               const EntityId& senderId,
                               const EntityId& receiverId = nox::ecs::Event::BROADCAST);
+
+            /**
+             * @brief      Creates an event of type Payload::TYPE, carrying
+             *             payload. The event is not added to the EventSystem,
+             *             this is done through the sendEntityEvent function.
+             *
+             * @see        nox::ecs::Event::setPayload
+             *
+             * @param[in]  payload     The payload, copied into the event.
+             * @param[in]  senderId    The id of the sender.
+             * @param[in]  receiverId  The id of the receiver entity. Defaults
+             *                         to Event::BROADCAST, i.e. Every entity
+             *                         within the system will see the message.
+             *
+             * @tparam     Payload     See nox::ecs::Event::setPayload. The
+             *                         overload is only considered for types
+             *                         declaring a TYPE.
+             *
+             * @return     An event that can be further customized.
+             */
+            template<class Payload, class = decltype(Payload::TYPE)>
+            nox::ecs::Event
+            createEntityEvent(const Payload& payload,
+                              const EntityId& senderId,
+                              const EntityId& receiverId = nox::ecs::Event::BROADCAST);
             
             /**
              * @brief      Queues up the sending of the entity event.
@@ -501,6 +914,41 @@ namespace nox
             virtual void
             onEvent(const std::shared_ptr<nox::event::Event>& event) override final;
 
+            /**
+             * @brief      Calls function(i) for every i in [begin, end) on the
+             *             threads of the EntityManager, returning when all
+             *             calls are done. Can be used from within component
+             *             functions, i.e. update, without adding threads.
+             *
+             * @see        nox::thread::parallelFor
+             *
+             * @param[in]  begin     The first index.
+             * @param[in]  end       One past the last index.
+             * @param[in]  grain     Largest number of indices run as one
+             *                       task, 0 chooses automatically.
+             * @param[in]  function  Called as function(std::size_t), must be
+             *                       safe to call concurrently.
+             */
+            template<class Function>
+            void
+            parallelFor(std::size_t begin,
+                        std::size_t end,
+                        std::size_t grain,
+                        const Function& function);
+
+            /**
+             * @brief      Calls all the functions concurrently on the threads
+             *             of the EntityManager, returning when all calls are
+             *             done.
+             *
+             * @see        nox::thread::parallelInvoke
+             *
+             * @param[in]  functions  The functions to call.
+             */
+            template<class... Functions>
+            void
+            parallelInvoke(Functions&&... functions);
+
             /**
              * @brief      Sets the logic context.
              *
@@ -517,6 +965,81 @@ namespace nox
             nox::logic::Logic*
             getLogicContext() const;
 
+            /**
+             * @brief      Sets the recorder that the requests given to the
+             *             EntityManager are written to, see TraceRecorder.
+             *             Recording is off by default, and only costs a null
+             *             check per request while it is off.
+             *
+             * @param      recorder  The recorder, nullptr turns recording off.
+             *                       Must stay alive for as long as it is
+             *                       set, the destruction of the
+             *                       EntityManager is not recorded.
+             */
+            void
+            setTraceRecorder(TraceRecorder* recorder);
+
+            /**
+             * @brief      Value identifying the start of a snapshot, "NOXS".
+             */
+            static constexpr std::uint32_t SNAPSHOT_MAGIC = 0x53584F4E;
+
+            /**
+             * @brief      Version of the snapshot format.
+             */
+            static constexpr std::uint32_t SNAPSHOT_VERSION = 1;
+
+            /**
+             * @brief      Writes every component to stream as a binary
+             *             snapshot, which loadSnapshot can restore. Each
+             *             component collection is written in bulk, see
+             *             ComponentCollection::writeSnapshot.
+             *
+             *             Must be called between steps. Requests and events
+             *             that are not yet handled are not part of the
+             *             snapshot, and neither are the entity definitions.
+             *
+             * @note       Values are written in native byte order, and
+             *             trivially copyable components as their bytes, so a
+             *             snapshot can only be loaded by the same build on
+             *             the same platform.
+             *
+             * @param      stream  The stream to write to, must be opened in
+             *                     binary mode.
+             *
+             * @return     false if the stream failed, or a component type
+             *             that has components is neither trivially copyable
+             *             nor has serialize and deserialize operations.
+             *             Nothing is written in the latter case.
+             */
+            bool
+            saveSnapshot(std::ostream& stream) const;
+
+            /**
+             * @brief      Restores a snapshot written by saveSnapshot. The
+             *             EntityManager must have the component types that
+             *             had components in the snapshot registered and
+             *             configured, and no components. The components
+             *             are restored in the lifecycle state they were
+             *             saved in, without any lifecycle operations being
+             *             called, and new entities get ids after the ones in
+             *             the snapshot.
+             *
+             *             The load is not recorded by the TraceRecorder.
+             *
+             * @param      stream  The stream to read from, must be opened in
+             *                     binary mode.
+             *
+             * @return     false if the EntityManager already has
+             *             components, in which case nothing is read, or if
+             *             the snapshot is malformed or does not match the
+             *             registered component types. Collections
+             *             before the failing one are restored, so the
+             *             EntityManager should be discarded.
+             */
+            bool
+            loadSnapshot(std::istream& stream);
+
         private:
             /**
              * @brief      Enum wrapper allowing for the use of enums as indexes
@@ -547,8 +1070,27 @@ namespace nox
                 TypeIdentifier type{0};
             };
 
+            /**
+             * @brief      Compact creation request. The json value or
+             *             component to create from is either referenced, or
+             *             kept in creationPayloads, so requests stay
+             *             trivially copyable and fit in a cache line.
+             */
             struct CreationArguments
             {
+                /**
+                 * @brief      What the component is created from.
+                 */
+                enum class Kind : std::uint8_t
+                {
+                    DEFAULT,
+                    JSON,
+                    JSON_REFERENCE,
+                    CHILDREN,
+                    PARENT,
+                    PROTOTYPE,
+                };
+
                 CreationArguments() = default;
                 CreationArguments(EntityId id, TypeIdentifier type)
                     : id(id)
@@ -557,38 +1099,211 @@ namespace nox
 
                 EntityId id{0};
                 TypeIdentifier type{0};
-                Json::Value json{};
-                Children children{0, nullptr};
-                Parent parent{0, nullptr};
+
+                /**
+                 * @brief      Number of entities, starting at id, that get
+                 *             the component.
+                 */
+                std::size_t count{1};
+
+                Kind kind{Kind::DEFAULT};
+
+                /**
+                 * @brief      Index into creationPayloads of the thread
+                 *             that made the request.
+                 */
+                std::uint8_t payloadTable{0};
+
+                /**
+                 * @brief      Index into the payload table of kind.
+                 */
+                std::size_t payload{0};
+
+                const Component* prototype{nullptr};
+                const Json::Value* json{nullptr};
             };
 
+            static_assert(std::is_trivially_copyable<CreationArguments>::value &&
+                          sizeof(CreationArguments) + sizeof(void*) <= 64,
+                          "CreationArguments should be a trivially copyable request, fitting in a cache line with its node");
+
+            /**
+             * @brief      Side tables holding the payloads of the creation
+             *             requests made by one thread until createStep.
+             *             Padded to a multiple of a cache line rather than
+             *             aligned, as new does not honour over-alignment
+             *             before C++17.
+             */
+            struct CreationPayloads
+            {
+                static constexpr std::size_t TABLES_SIZE =
+                    sizeof(std::vector<Json::Value>) + sizeof(std::vector<Children>) + sizeof(std::vector<Parent>);
+
+                std::vector<Json::Value> json{};
+                std::vector<Children> children{};
+                std::vector<Parent> parents{};
+                char padding[64 - TABLES_SIZE % 64];
+            };
+
+            static_assert(nox::thread::ThreadIndex::INVALID <= std::numeric_limits<std::uint8_t>::max(),
+                          "The payload table index must fit in CreationArguments::payloadTable");
+
+            /**
+             * @brief      Adds payload to table of the creation payloads of
+             *             the calling thread, and points request at it.
+             */
+            template<class T, class U>
+            void
+            addCreationPayload(std::vector<T> CreationPayloads::* table,
+                               U&& payload,
+                               CreationArguments& request);
+
             template<class T>
             using ContainerType = nox::thread::LockFreeStack<T>;
 
             ComponentCollection&
             getCollection(const TypeIdentifier& identifier);
 
+            /**
+             * @brief      Runs function once for every collection index in the
+             *             layer on the thread pool, and waits for all of them
+             *             to finish, helping out on the calling thread. The
+             *             tasks are submitted as one batch.
+             *
+             * @param[in]  layer     The collection indices in the layer.
+             * @param[in]  function  Called as function(index), must be safe
+             *                       to call concurrently for the indices
+             *                       within the layer.
+             */
+            template<class Function>
+            void
+            executeLayer(const std::vector<std::size_t>& layer, const Function& function);
+
+            /**
+             * @brief      Removes all coalesced events from entityEventWave
+             *             that are followed by an event with the same type,
+             *             sender and receiver, keeping the order of the rest.
+             */
+            void
+            coalesceEntityEventWave();
+
+            /**
+             * @brief      A coalesced event within entityEventWave.
+             */
+            struct CoalescedEvent
+            {
+                std::size_t type;
+                EntityId sender;
+                EntityId receiver;
+                std::size_t index;
+            };
+
             Factory factory{*this};
 
             std::vector<ComponentCollection> components{};
 
+            /**
+             * @brief      Maps the value of a type identifier to its index in
+             *             components, filled in registerComponent.
+             */
+            std::unordered_map<std::size_t, std::size_t> collectionIndices{};
+
             std::array<ContainerType<ComponentIdentifier>, Transition::META_COUNT> transitionRequests{};
 
             ContainerType<CreationArguments> creationRequests{};
+
+            /**
+             * @brief      Creation payloads per thread, indexed by
+             *             ThreadIndex, so concurrent requests don't contend.
+             *             Threads without an index share the last table,
+             *             guarded by unindexedPayloadMutex.
+             */
+            std::array<CreationPayloads, nox::thread::ThreadIndex::MAX_COUNT + 1> creationPayloads{};
+            std::mutex unindexedPayloadMutex{};
             ContainerType<ComponentIdentifier> removalRequests{};
 
             ContainerType<std::shared_ptr<nox::event::Event>> logicEvents{};
 
-            nox::thread::Pool<nox::thread::LockFreeStack> threads{};
+            #ifdef NOX_ECS_WORK_STEALING_POOL
+            using ThreadPool = nox::thread::WorkStealingPool;
+            #else
+            using ThreadPool = nox::thread::Pool<nox::thread::LockFreeStack>;
+            #endif
 
-            nox::ecs::Event::ArgumentAllocator eventArgumentAllocator{};
+            /**
+             * @brief      The pool created by the EntityManager, nullptr if
+             *             an external executor was given.
+             */
+            std::unique_ptr<ThreadPool> ownedThreads{};
 
-            ContainerType<nox::ecs::Event> entityEvents{};
+            /**
+             * @brief      The executor running the layered execution, either
+             *             ownedThreads or the executor given by the user.
+             */
+            nox::thread::Executor* threads{};
+
+            /**
+             * @brief      Tasks of the layer currently being submitted by
+             *             executeLayer. Kept as a member to reuse the memory
+             *             between layers.
+             */
+            std::vector<ThreadPool::Task> layerTasks{};
+
+            /**
+             * @brief      Arguments of entity events, one allocator for each
+             *             buffer in entityEvents, each with one arena per
+             *             sending thread. Events are created with the
+             *             allocator of the buffer they are sent to, which is
+             *             reset as soon as the buffer has been distributed.
+             */
+            std::array<nox::ecs::Event::ArgumentAllocator, 2> eventArgumentAllocators{};
+
+            /**
+             * @brief      Double buffered entity events. Events are sent into
+             *             the buffer indexed by entityEventBuffer, while the
+             *             other buffer is drained by distributeEntityEvents.
+             *
+             *             Memory Order: entityEventBuffer is only changed by
+             *             the thread running distributeEntityEvents while no
+             *             tasks are running, acquire release is enough for
+             *             senders to see the change.
+             */
+            std::array<ContainerType<nox::ecs::Event>, 2> entityEvents{};
+            std::atomic<std::size_t> entityEventBuffer{0};
+
+            /**
+             * @brief      The events of the wave currently being distributed.
+             *             Kept as a member to reuse the memory between waves.
+             */
+            std::vector<nox::ecs::Event> entityEventWave{};
+
+            /**
+             * @brief      The event types set through
+             *             setEntityEventCoalescing, kept sorted.
+             */
+            std::vector<std::size_t> coalescedEntityEventTypes{event_type::TRANSFORM_CHANGE};
+
+            /**
+             * @brief      Used by coalesceEntityEventWave. Kept as a member to
+             *             reuse the memory between waves.
+             */
+            std::vector<CoalescedEvent> coalescedEvents{};
+
+            std::size_t entityEventWaveLimit{std::numeric_limits<std::size_t>::max()};
+            nox::Duration entityEventTimeBudget{nox::Duration::max()};
 
             std::atomic<EntityId> currentEntityId{};
 
+            /**
+             * @brief      See advanceChangeTick, starts at 1 so a since of 0
+             *             visits every component.
+             */
+            ComponentCollection::ChangeTick changeTick{1};
+
             nox::logic::Logic* logicContext{};
 
+            TraceRecorder* traceRecorder{nullptr};
+
             #ifdef NOX_ECS_LAYERED_EXECUTION_UPDATE
             std::vector<std::vector<std::size_t>> updateExecutionLayers{};
             #endif
@@ -604,4 +1319,6 @@ namespace nox
     }
 }
 
+#include <nox/ecs/EntityManager.tpp>
+
 #endif
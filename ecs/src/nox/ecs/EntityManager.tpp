@@ -0,0 +1,57 @@
+#include <utility>
+
+template<class Function>
+void
+nox::ecs::EntityManager::parallelFor(std::size_t begin,
+                                     std::size_t end,
+                                     std::size_t grain,
+                                     const Function& function)
+{
+    nox::thread::parallelFor(*this->threads, begin, end, grain, function);
+}
+
+template<class... Functions>
+void
+nox::ecs::EntityManager::parallelInvoke(Functions&&... functions)
+{
+    nox::thread::parallelInvoke(*this->threads, std::forward<Functions>(functions)...);
+}
+
+template<class Payload, class>
+nox::ecs::Event
+nox::ecs::EntityManager::createEntityEvent(const Payload& payload,
+                                           const EntityId& senderId,
+                                           const EntityId& receiverId)
+{
+    auto event = this->createEntityEvent(TypeIdentifier(Payload::TYPE), senderId, receiverId);
+    event.setPayload(payload);
+    return event;
+}
+
+template<class T, class U>
+void
+nox::ecs::EntityManager::addCreationPayload(std::vector<T> CreationPayloads::* table,
+                                            U&& payload,
+                                            CreationArguments& request)
+{
+    const auto index = nox::thread::ThreadIndex::get();
+    std::unique_lock<std::mutex> lock(this->unindexedPayloadMutex, std::defer_lock);
+    if (index == nox::thread::ThreadIndex::INVALID)
+    {
+        lock.lock();
+    }
+
+    auto& payloads = this->creationPayloads[index].*table;
+    payloads.emplace_back(std::forward<U>(payload));
+    request.payloadTable = static_cast<std::uint8_t>(index);
+    request.payload = payloads.size() - 1;
+}
+
+template<class Function>
+void
+nox::ecs::EntityManager::forEachChangedComponent(const TypeIdentifier& identifier,
+                                                 ComponentCollection::ChangeTick since,
+                                                 const Function& function)
+{
+    this->getCollection(identifier).forEachChanged(since, function);
+}
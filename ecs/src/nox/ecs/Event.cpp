@@ -1,9 +1,14 @@
 #include <nox/ecs/Event.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
 ///////////
 // Event //
 ///////////
 
 const nox::ecs::EntityId nox::ecs::Event::BROADCAST = std::numeric_limits<nox::ecs::EntityId>::max();
+constexpr std::size_t nox::ecs::Event::INITIAL_ARGUMENT_CAPACITY;
 
 nox::ecs::Event::Event(ArgumentAllocator* allocator,
                        const TypeIdentifier& eventType,
@@ -22,9 +27,17 @@ nox::ecs::Event::Event(Event&& source)
     , senderId(source.senderId)
     , type(source.type)
     , allocator(source.allocator)
-    , first(source.first)
+    , arguments(source.arguments)
+    , argumentCount(source.argumentCount)
+    , argumentCapacity(source.argumentCapacity)
+    , payload(source.payload)
+    , payloadSize(source.payloadSize)
+    , payloadAlignment(source.payloadAlignment)
 {
-    source.first = nullptr;
+    source.arguments = nullptr;
+    source.argumentCount = 0;
+    source.argumentCapacity = 0;
+    source.payload = nullptr;
 }
 
 nox::ecs::Event&
@@ -32,89 +45,93 @@ nox::ecs::Event::operator=(Event&& source)
 {
     if (this != &source)
     {
-        while (first)
-        {
-            auto next = first->next;
-            first->destructor(first->payload);
-            allocator->deallocate(first);
-            first = next;
-        }
+        this->destroyArguments();
 
         this->receiverId = source.receiverId;
         this->senderId = source.senderId;
         this->type = source.type;
         this->allocator = source.allocator;
-        this->first = source.first;
+        this->arguments = source.arguments;
+        this->argumentCount = source.argumentCount;
+        this->argumentCapacity = source.argumentCapacity;
+        this->payload = source.payload;
+        this->payloadSize = source.payloadSize;
+        this->payloadAlignment = source.payloadAlignment;
 
-        source.first = nullptr;
+        source.arguments = nullptr;
+        source.argumentCount = 0;
+        source.argumentCapacity = 0;
+        source.payload = nullptr;
     }
     return *this;
 }
 
 nox::ecs::Event::~Event()
 {
-    while (first)
-    {
-        auto next = first->next;
-        first->destructor(first->payload);
-        allocator->deallocate(first);
-        first = next;
-    }
+    this->destroyArguments();
 }
 
 void
-nox::ecs::Event::addArgument(Argument* argument)
+nox::ecs::Event::addArgument(const TypeIdentifier& identifier,
+                             nox::memory::Byte* payload,
+                             Argument::Destructor destructor,
+                             std::size_t size,
+                             std::size_t alignment)
 {
-    NOX_ASSERT(!this->isDuplicate(argument->getIdentifier()), "Event was given duplicate arguments!");
+    auto position = this->findArgument(identifier);
+    NOX_ASSERT(position == this->arguments + this->argumentCount || position->getIdentifier() != identifier,
+               "Event was given duplicate arguments!");
 
-    if (!first)
+    if (this->argumentCount == this->argumentCapacity)
     {
-        first = argument;
-        return;
-    }
+        // The old table is left to the allocator, which reclaims it together with the payloads.
+        const auto index = static_cast<std::size_t>(position - this->arguments);
+        const auto capacity = std::max(INITIAL_ARGUMENT_CAPACITY, this->argumentCapacity * 2);
+        auto table = static_cast<Argument*>(this->allocator->allocate(sizeof(Argument) * capacity, alignof(Argument)));
 
-    auto before = first; 
-    auto itr = first->next;
-    while (itr)
-    {
-        before = itr;
-        itr = itr->next;
+        if (this->argumentCount != 0)
+        {
+            std::uninitialized_copy(this->arguments, this->arguments + this->argumentCount, table);
+            this->allocator->deallocate(this->arguments);
+        }
+
+        this->arguments = table;
+        this->argumentCapacity = capacity;
+        position = table + index;
     }
-    before->next = argument;
+
+    // Arguments are trivially copyable, so the tail can be shifted without construction.
+    std::memmove(static_cast<void*>(position + 1),
+                 static_cast<const void*>(position),
+                 sizeof(Argument) * static_cast<std::size_t>(this->arguments + this->argumentCount - position));
+    new(position) Argument(identifier, payload, destructor, size, alignment);
+    ++this->argumentCount;
 }
 
 bool
 nox::ecs::Event::hasArgument(const TypeIdentifier& identifier) const
 {
-    auto itr = first;
-    while (itr)
-    {
-        if (itr->getIdentifier() == identifier)
-        {
-            return true;
-        }
-        itr = itr->next;
-    }
-    return false;
+    const auto position = this->findArgument(identifier);
+    return position != this->arguments + this->argumentCount &&
+           position->getIdentifier() == identifier;
 }
 
 
 const nox::ecs::Event::Argument&
 nox::ecs::Event::getArgument(const TypeIdentifier& identifier) const
 {
-    auto itr = first;
-    while (itr)
-    {
-        if (itr->getIdentifier() == identifier)
-        {
-            break;
-        }
-        itr = itr->next;
-    }
+    const auto position = this->findArgument(identifier);
+
+    NOX_ASSERT(position != this->arguments + this->argumentCount && position->getIdentifier() == identifier,
+               "Event has no argument with type identifier: %zu", identifier.getValue());
 
-    NOX_ASSERT(itr, "Event has no argument with type identifier: %zu", identifier.getValue());
+    return *position;
+}
 
-    return *itr;
+bool
+nox::ecs::Event::hasPayload() const
+{
+    return this->payload != nullptr;
 }
 
 const nox::ecs::TypeIdentifier&
@@ -141,19 +158,47 @@ nox::ecs::Event::getAllocator()
     return *this->allocator;
 }
 
-bool 
-nox::ecs::Event::isDuplicate(const TypeIdentifier& identifier) const
+nox::ecs::Event::Argument*
+nox::ecs::Event::findArgument(const TypeIdentifier& identifier) const
 {
-    auto itr = first;
-    while (itr)
+    return std::lower_bound(this->arguments,
+                            this->arguments + this->argumentCount,
+                            identifier,
+                            [](const Argument& argument, const TypeIdentifier& value)
+                            {
+                                return argument.getIdentifier().getValue() < value.getValue();
+                            });
+}
+
+void
+nox::ecs::Event::destroyArguments()
+{
+    for (std::size_t i = 0; i < this->argumentCount; ++i)
     {
-        if (itr->getIdentifier() == identifier)
+        if (this->arguments[i].destructor)
         {
-            return true;
+            this->arguments[i].destructor(this->arguments[i].payload);
         }
-        itr = itr->next;
+        this->allocator->deallocate(this->arguments[i].payload);
+    }
+
+    if (this->arguments)
+    {
+        this->allocator->deallocate(this->arguments);
+    }
+
+    this->arguments = nullptr;
+    this->argumentCount = 0;
+    this->argumentCapacity = 0;
+
+    // Payloads are trivially destructible, so only the memory is given back.
+    if (this->payload)
+    {
+        this->allocator->deallocate(this->payload);
+        this->payload = nullptr;
+        this->payloadSize = 0;
+        this->payloadAlignment = 0;
     }
-    return false;
 }
 
 /////////////////////
@@ -161,41 +206,32 @@ nox::ecs::Event::isDuplicate(const TypeIdentifier& identifier) const
 /////////////////////
 nox::ecs::Event::Argument::Argument(const TypeIdentifier& identifier,
                                     nox::memory::Byte* payload,
-                                    Destructor destructor)
+                                    Destructor destructor,
+                                    std::size_t size,
+                                    std::size_t alignment)
     : identifier(identifier)
     , payload(payload)
     , destructor(destructor)
+    , size(static_cast<std::uint32_t>(size))
+    , alignment(static_cast<std::uint32_t>(alignment))
 {
 
 }
 
-nox::ecs::Event::Argument::Argument(Event::Argument&& source)
-    : identifier(source.identifier)
-    , payload(source.payload)
-    , destructor(source.destructor)
+const nox::ecs::TypeIdentifier&
+nox::ecs::Event::Argument::getIdentifier() const
 {
-    source.payload = nullptr;
-    source.destructor = nullptr;
+    return this->identifier;
 }
 
-nox::ecs::Event::Argument&
-nox::ecs::Event::Argument::operator=(Event::Argument&& source)
+std::size_t
+nox::ecs::Event::Argument::getSize() const
 {
-    if (this != &source)
-    {
-        this->destructor(payload);
-        this->destructor = source.destructor;
-        this->payload = source.payload;
-        this->identifier = source.identifier;
-
-        source.destructor = nullptr;
-        source.payload = nullptr;
-    }
-    return *this;
+    return this->size;
 }
 
-const nox::ecs::TypeIdentifier&
-nox::ecs::Event::Argument::getIdentifier() const
+std::size_t
+nox::ecs::Event::Argument::getAlignment() const
 {
-    return this->identifier;
+    return this->alignment;
 }
@@ -1,11 +1,21 @@
 #ifndef NOX_ECS_EVENT_H_
 #define NOX_ECS_EVENT_H_
+#include <cstdint>
 #include <limits>
 #include <type_traits>
 
 #include <nox/ecs/EntityId.h>
 #include <nox/ecs/TypeIdentifier.h>
-#include <nox/memory/LockFreeAllocator.h>
+#include <nox/memory/ThreadLocalAllocator.h>
+
+namespace nox
+{
+    namespace ecs
+    {
+        class TraceRecorder;
+        class TraceReplayer;
+    }
+}
 
 namespace nox
 {
@@ -22,6 +32,8 @@ namespace nox
              * @brief      Class for holding arguments within the event. The
              *             class is a non owning container for memory, it is the
              *             events job to destroy all of its arguments properly.
+             *             As it only refers to the payload, it can be copied
+             *             freely.
              */
             class Argument
             {
@@ -34,7 +46,8 @@ namespace nox
 
                 /**
                  * @brief      Function pointer to allow for destruction while
-                 *             maintaining types info.
+                 *             maintaining types info. nullptr for trivially
+                 *             destructible payloads.
                  */
                 using Destructor = void(*)(nox::memory::Byte*);
 
@@ -51,42 +64,18 @@ namespace nox
                  * @param[in]  identifier  The type identifier of the type to put in
                  *                         the argument.
                  * @param[in]  destructor  The destructor to use when destroying the
-                 *                         argument.
+                 *                         argument, or nullptr if the payload
+                 *                         is trivially destructible.
+                 * @param[in]  size        The size of the payload if it is
+                 *                         trivially copyable, 0 otherwise.
+                 * @param[in]  alignment   The alignment of the payload if it
+                 *                         is trivially copyable, 0 otherwise.
                  */
                 Argument(const TypeIdentifier& identifier,
                          nox::memory::Byte* payload,
-                         Destructor destructor);
-
-                /**
-                 * @brief      Not allowing for copy construction, only movement.
-                 */
-                Argument(const Argument&) = delete;
-
-                /**
-                 * @brief      Now allowing for copy assignment, only movement.
-                 */
-                Argument& operator=(const Argument&) = delete;
-
-                /**
-                 * @brief      Move constructor of the argument.
-                 * 
-                 * @warning    source is not valid after movement.
-                 *
-                 * @param[in]  source The argument to move from.
-                 */
-                Argument(Argument&& source);
-
-                /**
-                 * @brief      Move assignment operator. Move assigns from source.
-                 *             Class is tolerant of self-assignment.
-                 *             
-                 * @warning    source is not valid after movement.
-                 *             
-                 * @param[in]  source The argument to move assign from.
-                 *
-                 * @return     *this after assignment.
-                 */
-                Argument& operator=(Argument&& source);
+                         Destructor destructor,
+                         std::size_t size = 0,
+                         std::size_t alignment = 0);
 
                 /**
                  * @brief      Returns a pointer to the value held within the
@@ -138,17 +127,42 @@ namespace nox
                 const TypeIdentifier& 
                 getIdentifier() const;
 
+                /**
+                 * @brief      Returns the size of the payload, if it can be
+                 *             copied bytewise.
+                 *
+                 * @return     The size of the payload in bytes, 0 if it is
+                 *             not trivially copyable.
+                 */
+                std::size_t
+                getSize() const;
+
+                /**
+                 * @brief      Returns the alignment of the payload, if it can
+                 *             be copied bytewise.
+                 *
+                 * @return     The alignment of the payload, 0 if it is not
+                 *             trivially copyable.
+                 */
+                std::size_t
+                getAlignment() const;
+
             private:
-                Argument* next{};
                 TypeIdentifier identifier;
                 nox::memory::Byte* payload;
                 Destructor destructor;
+                std::uint32_t size{0};
+                std::uint32_t alignment{0};
             };
 
             /**
-             * @brief      Allocator used for allocating events.
+             * @brief      Allocator used for allocating events. Every thread
+             *             allocates arguments from its own arena, so sending
+             *             events from parallel updates does not contend.
+             *             Large payloads go into separate large blocks, and
+             *             are freed in bulk with the rest.
              */
-            using ArgumentAllocator = nox::memory::LockFreeAllocator<1024>;
+            using ArgumentAllocator = nox::memory::ThreadLocalAllocator<1024>;
            
             /**
              * @brief      Constant value used to signal that an event shall be
@@ -197,8 +211,16 @@ namespace nox
             Event(Event&& source);
 
             /**
-             * @brief      Deleting move assignment operator as references to
-             *             allocators prohibits moving properly.
+             * @brief      Move assignment operator. Destroys the arguments of
+             *             this event, then takes over the arguments, payload
+             *             and allocator of source. The class is tolerant of
+             *             self-assignment.
+             *
+             * @warning    source will not be usable after moving.
+             *
+             * @param[in]  source  the Event to move from.
+             *
+             * @return     *this after assignment.
              */
             Event& operator=(Event&& source);
 
@@ -209,14 +231,28 @@ namespace nox
             ~Event();
 
             /**
-             * @brief      Adds an argument to the event.
+             * @brief      Adds an argument to the event, keeping the argument
+             *             table sorted on identifier. The event takes
+             *             ownership of the payload, and destroys it through
+             *             destructor.
              *
-             * @param[in]  identifier  The identifier of the argument.
-             * @param[in]  argument    The argument itself. It is moved from and
-             *                         is not valid after movement.
+             * @param[in]  identifier  The identifier of the argument, must not
+             *                         already be in the event.
+             * @param      payload     The payload, allocated through
+             *                         getAllocator.
+             * @param[in]  destructor  The destructor of the payload, nullptr
+             *                         if it is trivially destructible.
+             * @param[in]  size        The size of the payload if it is
+             *                         trivially copyable, 0 otherwise.
+             * @param[in]  alignment   The alignment of the payload if it is
+             *                         trivially copyable, 0 otherwise.
              */
             void 
-            addArgument(Argument* argument);
+            addArgument(const TypeIdentifier& identifier,
+                        nox::memory::Byte* payload,
+                        Argument::Destructor destructor,
+                        std::size_t size = 0,
+                        std::size_t alignment = 0);
 
             /**
              * @brief      Checks if the event has an argument with the
@@ -245,6 +281,48 @@ namespace nox
             const Argument&
             getArgument(const TypeIdentifier& identifier) const;
 
+            /**
+             * @brief      Gives the event a single POD payload, copied once
+             *             into memory from getAllocator. Cheaper than one
+             *             argument per field, both to create and to read.
+             *
+             * @tparam     T     Trivially copyable and destructible type,
+             *                   declaring the event type it belongs to as
+             *                   static constexpr std::size_t TYPE, which must
+             *                   equal getType().
+             *                   sizeof(T) + alignment padding <=
+             *                   ArgumentAllocator::MAX_SIZE.
+             *
+             * @param[in]  payload  The payload to copy into the event. The
+             *                      event must not have a payload already.
+             */
+            template<class T>
+            void
+            setPayload(const T& payload);
+
+            /**
+             * @brief      Checks if the event has a payload.
+             *
+             * @return     True if setPayload has been called on the event.
+             */
+            bool
+            hasPayload() const;
+
+            /**
+             * @brief      Gets the payload of the event, without copying it.
+             *
+             * @warning    Only the event type is checked, against T::TYPE.
+             *             Reading a payload of another type with the same
+             *             TYPE is undefined behavior.
+             *
+             * @tparam     T     The type given to setPayload.
+             *
+             * @return     The payload of the event.
+             */
+            template<class T>
+            const T&
+            getPayload() const;
+
             /**
              * @brief      Returns the event type.
              *
@@ -279,13 +357,63 @@ namespace nox
             getAllocator();
 
         private:
-            bool isDuplicate(const TypeIdentifier& identifier) const;
+            /**
+             * @brief      Recording and replaying events need the raw
+             *             arguments and payload.
+             */
+            friend TraceRecorder;
+            friend TraceReplayer;
+
+            /**
+             * @brief      Capacity of the argument table when the first
+             *             argument is added, doubled whenever it is full.
+             */
+            static constexpr std::size_t INITIAL_ARGUMENT_CAPACITY = 4;
+
+            /**
+             * @brief      Finds the first argument whose identifier is not
+             *             less than identifier.
+             *
+             * @param[in]  identifier  The identifier to search for.
+             *
+             * @return     Pointer into the argument table, one past the end
+             *             if all identifiers are less.
+             */
+            Argument* findArgument(const TypeIdentifier& identifier) const;
+
+            /**
+             * @brief      Destroys all payloads and gives the argument table
+             *             back to the allocator.
+             */
+            void destroyArguments();
+
+            /**
+             * @brief      Compile time checks shared by setPayload and
+             *             getPayload.
+             */
+            template<class T>
+            static constexpr bool isPayload();
 
             EntityId receiverId;
             EntityId senderId;
             TypeIdentifier type;
             ArgumentAllocator* allocator{nullptr};
-            Argument* first{nullptr};
+
+            /**
+             * @brief      Arguments sorted on identifier, allocated through
+             *             allocator next to the payloads, so looking one up
+             *             is a binary search within a cache line or two.
+             */
+            Argument* arguments{nullptr};
+            std::size_t argumentCount{0};
+            std::size_t argumentCapacity{0};
+
+            /**
+             * @brief      See setPayload, nullptr if the event has none.
+             */
+            nox::memory::Byte* payload{nullptr};
+            std::uint32_t payloadSize{0};
+            std::uint32_t payloadAlignment{0};
         };
     }
 }
@@ -1,3 +1,7 @@
+#include <new>
+
+#include <nox/util/nox_assert.h>
+
 template<class T>
 typename std::enable_if<std::is_pointer<T>::value &&
                         std::is_const<std::remove_pointer_t<T>>::value,
@@ -15,3 +19,41 @@ nox::ecs::Event::Argument::value() const
 {
     return *reinterpret_cast<const T*>(this->payload);
 }
+
+template<class T>
+constexpr bool
+nox::ecs::Event::isPayload()
+{
+    return std::is_trivially_copyable<T>::value &&
+           std::is_trivially_destructible<T>::value &&
+           std::is_convertible<decltype(T::TYPE), std::size_t>::value;
+}
+
+template<class T>
+void
+nox::ecs::Event::setPayload(const T& payload)
+{
+    static_assert(isPayload<T>(), "T must be trivially copyable and destructible, and declare its event TYPE");
+    static_assert(sizeof(T) + ArgumentAllocator::getWorstCasePadding(alignof(T)) <= ArgumentAllocator::MAX_SIZE,
+                  "sizeof T + padding is larger than ArgumentAllocator::MAX_SIZE");
+    NOX_ASSERT(TypeIdentifier(T::TYPE) == this->type,
+               "Payload belongs to event type %zu, but event has type %zu", T::TYPE, this->type.getValue());
+    NOX_ASSERT(!this->payload, "Event already has a payload!");
+
+    this->payload = static_cast<nox::memory::Byte*>(this->allocator->allocate(sizeof(T), alignof(T)));
+    new(this->payload) T(payload);
+    this->payloadSize = sizeof(T);
+    this->payloadAlignment = alignof(T);
+}
+
+template<class T>
+const T&
+nox::ecs::Event::getPayload() const
+{
+    static_assert(isPayload<T>(), "T must be trivially copyable and destructible, and declare its event TYPE");
+    NOX_ASSERT(TypeIdentifier(T::TYPE) == this->type,
+               "Payload belongs to event type %zu, but event has type %zu", T::TYPE, this->type.getValue());
+    NOX_ASSERT(this->payload, "Event has no payload!");
+
+    return *reinterpret_cast<const T*>(this->payload);
+}
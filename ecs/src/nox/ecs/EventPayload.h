@@ -0,0 +1,37 @@
+#ifndef NOX_ECS_EVENTPAYLOAD_H_
+#define NOX_ECS_EVENTPAYLOAD_H_
+#include <cstddef>
+
+#include <nox/ecs/EventType.h>
+
+#include <glm/vec2.hpp>
+
+namespace nox
+{
+    namespace ecs
+    {
+        /**
+         * @brief      Namespace containing the payloads of the standard events
+         *             used within the ecs.
+         *
+         * @see        nox::ecs::Event::setPayload
+         */
+        namespace event_payload
+        {
+            /**
+             * @brief      Payload of the transform_change event, sent by
+             *             Transform whenever it is changed.
+             */
+            struct TransformChange
+            {
+                static constexpr std::size_t TYPE = event_type::TRANSFORM_CHANGE;
+
+                glm::vec2 position;
+                glm::vec2 scale;
+                float rotation;
+            };
+        }
+    }
+}
+
+#endif
@@ -1,7 +1,165 @@
 #include <nox/ecs/Factory.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
 #include <nox/ecs/EntityManager.h>
 #include <nox/ecs/ComponentType.h>
+#include <nox/memory/alignment.h>
+
+namespace
+{
+    namespace local
+    {
+        /**
+         * @brief      How a component is stored in a compiled file.
+         */
+        enum class Encoding : std::uint8_t
+        {
+            JSON,
+            BYTES,
+        };
+
+        /**
+         * @brief      Prototypes written as bytes are aligned like the heap
+         *             allocated ones. The mapping itself is page aligned.
+         */
+        constexpr std::size_t PROTOTYPE_ALIGNMENT = alignof(std::max_align_t);
+
+        /**
+         * @brief      Writes values in native byte order, keeping track of
+         *             the offset within the stream for aligning prototypes.
+         */
+        class Writer
+        {
+        public:
+            explicit Writer(std::ostream& stream)
+                : stream(stream)
+            {
+                // Streams that cannot tell their position, like pipes, are assumed to start out aligned.
+                const auto position = stream.tellp();
+                this->offset = (position > 0) ? static_cast<std::size_t>(position) : 0;
+            }
+
+            void
+            write(const void* data, std::size_t size)
+            {
+                if (size != 0)
+                {
+                    this->stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+                    this->offset += size;
+                }
+            }
+
+            template<class T>
+            void
+            writeValue(T value)
+            {
+                this->write(&value, sizeof(value));
+            }
+
+            void
+            writeString(const std::string& value)
+            {
+                this->writeValue(static_cast<std::uint32_t>(value.size()));
+                this->write(value.data(), value.size());
+            }
+
+            void
+            pad(std::size_t alignment)
+            {
+                const char zero = 0;
+                while (this->offset % alignment != 0)
+                {
+                    this->write(&zero, sizeof(zero));
+                }
+            }
+
+        private:
+            std::ostream& stream;
+            std::size_t offset{0};
+        };
+
+        /**
+         * @brief      Reads values from a mapped file, every read is bounds
+         *             checked so a truncated file fails rather than reads
+         *             past the mapping.
+         */
+        class Reader
+        {
+        public:
+            Reader(const nox::memory::Byte* first, const nox::memory::Byte* last)
+                : cursor(first)
+                , last(last)
+            {
+            }
+
+            const nox::memory::Byte*
+            readBytes(std::size_t size)
+            {
+                if (static_cast<std::size_t>(this->last - this->cursor) < size)
+                {
+                    return nullptr;
+                }
+
+                const auto bytes = this->cursor;
+                this->cursor += size;
+                return bytes;
+            }
+
+            const nox::memory::Byte*
+            readBytes(std::size_t size, std::size_t alignment)
+            {
+                const auto padding = nox::memory::getAlignmentPadding(this->cursor, alignment);
+                return (this->readBytes(padding)) ? this->readBytes(size) : nullptr;
+            }
+
+            template<class T>
+            bool
+            readValue(T& value)
+            {
+                const auto bytes = this->readBytes(sizeof(value));
+                if (bytes)
+                {
+                    std::memcpy(&value, bytes, sizeof(value));
+                }
+                return bytes != nullptr;
+            }
+
+            bool
+            readString(std::string& value)
+            {
+                std::uint32_t size = 0;
+                if (!this->readValue(size))
+                {
+                    return false;
+                }
+
+                const auto bytes = this->readBytes(size);
+                if (bytes)
+                {
+                    value.assign(reinterpret_cast<const char*>(bytes), size);
+                }
+                return bytes != nullptr;
+            }
+
+            bool
+            isAtEnd() const
+            {
+                return this->cursor == this->last;
+            }
+
+        private:
+            const nox::memory::Byte* cursor;
+            const nox::memory::Byte* last;
+        };
+    }
+}
+
+constexpr std::uint32_t nox::ecs::Factory::MAGIC;
+constexpr std::uint32_t nox::ecs::Factory::VERSION;
 
 nox::ecs::Factory::Factory(EntityManager& entityManager)
     : entityManager(entityManager)
@@ -12,34 +170,291 @@ nox::ecs::Factory::Factory(EntityManager& entityManager)
 
 void
 nox::ecs::Factory::createEntity(const EntityId& id,
-                                const std::string& definitionName)
+                                const std::string& definitionName) const
 {
-    const auto definition = std::find_if(std::cbegin(this->definitions),
-                                         std::cend(this->definitions), 
-                                         [&definitionName](const auto& item)
-                                         { return item.name == definitionName; });
-    if (definition != std::cend(this->definitions))
-    {
-        this->createEntity(id, *definition);
-    }
+    this->createEntities(id, 1, definitionName);
 }
 
 void 
 nox::ecs::Factory::createEntityDefinition(const Json::Value& root)
 {
+    std::lock_guard<std::mutex> lock(this->definitionMutex);
+
+    std::unordered_set<std::string> addedNames;
     const auto names = root.getMemberNames();
     for (const auto& item : names)
     {
         EntityDefinition definition;
         definition.name = item;
         definition.json = root[item];
-        this->definitions.push_back(definition);
+        if (this->definitions.emplace(item, std::move(definition)).second)
+        {
+            addedNames.insert(item);
+        }
+    }
+
+    // The published map is never changed, the new prefabs are published in a copy.
+    const auto current = this->prefabs.load(std::memory_order_acquire);
+    auto prefabMap = current ? std::make_unique<PrefabMap>(*current) : std::make_unique<PrefabMap>();
+
+    // Definitions may extend definitions that are added later, so every prefab whose chain
+    // reaches one of the new definitions is flattened again.
+    for (const auto& item : this->definitions)
+    {
+        if (this->extendsAny(item.second, addedNames))
+        {
+            this->prefabStorage.push_back(this->createPrefab(item.second));
+            (*prefabMap)[item.first] = &this->prefabStorage.back();
+        }
     }
+
+    this->prefabs.store(prefabMap.get(), std::memory_order_release);
+    this->prefabMaps.push_back(std::move(prefabMap));
 }
 
 void
-nox::ecs::Factory::createEntity(const EntityId& id,
-                                const EntityDefinition& definition)
+nox::ecs::Factory::createEntities(const EntityId& firstId,
+                                  std::size_t count,
+                                  const std::string& definitionName) const
+{
+    const auto prefabs = this->prefabs.load(std::memory_order_acquire);
+    if (!prefabs)
+    {
+        return;
+    }
+
+    const auto prefab = prefabs->find(definitionName);
+    if (prefab != std::cend(*prefabs))
+    {
+        this->createEntities(firstId, count, *prefab->second);
+    }
+}
+
+bool
+nox::ecs::Factory::compileDefinitions(std::ostream& stream)
+{
+    std::lock_guard<std::mutex> lock(this->definitionMutex);
+
+    // Sorted, so the same definitions always compile to the same file.
+    const auto prefabs = this->prefabs.load(std::memory_order_acquire);
+    std::vector<std::string> names;
+    if (prefabs)
+    {
+        for (const auto& item : *prefabs)
+        {
+            names.push_back(item.first);
+        }
+    }
+    std::sort(std::begin(names), std::end(names));
+
+    local::Writer writer(stream);
+    writer.writeValue(MAGIC);
+    writer.writeValue(VERSION);
+    writer.writeValue(static_cast<std::uint32_t>(names.size()));
+
+    Json::FastWriter jsonWriter;
+    for (const auto& name : names)
+    {
+        const auto& prefab = *prefabs->at(name);
+        writer.writeString(name);
+
+        writer.writeValue(static_cast<std::uint8_t>(prefab.hasChildren));
+        writer.writeValue(static_cast<std::uint32_t>(prefab.children.size()));
+        for (const auto& child : prefab.children)
+        {
+            writer.writeString(child);
+        }
+
+        writer.writeValue(static_cast<std::uint32_t>(prefab.components.size()));
+        for (const auto& component : prefab.components)
+        {
+            writer.writeValue(static_cast<std::uint64_t>(component.identifier.getValue()));
+
+            const auto info = this->entityManager.findMetaInformation(component.identifier);
+            if (component.prototype && info && info->triviallyCopyable)
+            {
+                writer.writeValue(local::Encoding::BYTES);
+                writer.writeValue(static_cast<std::uint32_t>(info->size));
+                writer.pad(local::PROTOTYPE_ALIGNMENT);
+                writer.write(component.prototype, info->size);
+            }
+            else
+            {
+                const auto text = (component.json.isNull()) ? std::string() : jsonWriter.write(component.json);
+                writer.writeValue(local::Encoding::JSON);
+                writer.writeString(text);
+            }
+        }
+    }
+
+    return stream.good();
+}
+
+bool
+nox::ecs::Factory::loadCompiledDefinitions(const std::string& path)
+{
+    nox::memory::MappedFile file(path);
+    if (!file.isOpen())
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(this->definitionMutex);
+
+    local::Reader reader(file.data(), file.data() + file.size());
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    std::uint32_t prefabCount = 0;
+    if (!reader.readValue(magic) ||
+        !reader.readValue(version) ||
+        !reader.readValue(prefabCount) ||
+        magic != MAGIC ||
+        version != VERSION)
+    {
+        return false;
+    }
+
+    std::vector<std::pair<std::string, Prefab>> loadedPrefabs;
+    loadedPrefabs.reserve(std::min(std::size_t(prefabCount), file.size()));
+    for (std::uint32_t i = 0; i < prefabCount; ++i)
+    {
+        std::string name;
+        std::uint8_t hasChildren = 0;
+        std::uint32_t childCount = 0;
+        if (!reader.readString(name) ||
+            !reader.readValue(hasChildren) ||
+            !reader.readValue(childCount))
+        {
+            return false;
+        }
+
+        Prefab prefab;
+        prefab.hasChildren = (hasChildren != 0);
+        for (std::uint32_t j = 0; j < childCount; ++j)
+        {
+            std::string child;
+            if (!reader.readString(child))
+            {
+                return false;
+            }
+            prefab.children.push_back(std::move(child));
+        }
+
+        std::uint32_t componentCount = 0;
+        if (!reader.readValue(componentCount))
+        {
+            return false;
+        }
+
+        for (std::uint32_t j = 0; j < componentCount; ++j)
+        {
+            std::uint64_t identifierValue = 0;
+            local::Encoding encoding = local::Encoding::JSON;
+            std::uint32_t size = 0;
+            if (!reader.readValue(identifierValue) ||
+                !reader.readValue(encoding) ||
+                !reader.readValue(size))
+            {
+                return false;
+            }
+
+            const TypeIdentifier identifier(static_cast<std::size_t>(identifierValue));
+            if (encoding == local::Encoding::BYTES)
+            {
+                // The bytes are cloned in place, so the registered type must have the same layout.
+                const auto info = this->entityManager.findMetaInformation(identifier);
+                const auto bytes = reader.readBytes(size, local::PROTOTYPE_ALIGNMENT);
+                if (!bytes || !info || !info->triviallyCopyable || !info->clone || info->size != size)
+                {
+                    return false;
+                }
+
+                const auto prototype = reinterpret_cast<const Component*>(bytes);
+                prefab.components.push_back({ identifier, Json::Value(), prototype });
+            }
+            else if (encoding == local::Encoding::JSON)
+            {
+                const auto text = reinterpret_cast<const char*>(reader.readBytes(size));
+                Json::Value value;
+                Json::Reader jsonReader;
+                if (!text || (size != 0 && !jsonReader.parse(text, text + size, value)))
+                {
+                    return false;
+                }
+
+                const auto prototype = this->entityManager.createPrototype(identifier, value);
+                prefab.components.push_back({ identifier, std::move(value), prototype });
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        loadedPrefabs.emplace_back(std::move(name), std::move(prefab));
+    }
+
+    if (!reader.isAtEnd())
+    {
+        return false;
+    }
+
+    const auto current = this->prefabs.load(std::memory_order_acquire);
+    auto prefabMap = current ? std::make_unique<PrefabMap>(*current) : std::make_unique<PrefabMap>();
+    for (auto& item : loadedPrefabs)
+    {
+        if (prefabMap->count(item.first) == 0)
+        {
+            this->prefabStorage.push_back(std::move(item.second));
+            prefabMap->emplace(item.first, &this->prefabStorage.back());
+        }
+    }
+
+    this->prefabs.store(prefabMap.get(), std::memory_order_release);
+    this->prefabMaps.push_back(std::move(prefabMap));
+    this->compiledFiles.push_back(std::move(file));
+    return true;
+}
+
+void
+nox::ecs::Factory::createEntities(const EntityId& firstId,
+                                  std::size_t count,
+                                  const Prefab& prefab) const
+{
+    // Process children.
+    if (prefab.hasChildren)
+    {
+        auto childrenComponents = this->parseChildren(firstId, count, prefab.children);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            this->entityManager.assignComponent(firstId + i,
+                                                component_type::CHILDREN,
+                                                std::move(childrenComponents[i]));
+        }
+    }
+
+    for (const auto& component : prefab.components)
+    {
+        if (component.prototype)
+        {
+            this->entityManager.assignComponents(firstId,
+                                                 count,
+                                                 component.identifier,
+                                                 component.json,
+                                                 component.prototype);
+        }
+        else
+        {
+            this->entityManager.assignComponents(firstId,
+                                                 count,
+                                                 component.identifier,
+                                                 &component.json);
+        }
+    }
+}
+
+nox::ecs::Factory::Prefab
+nox::ecs::Factory::createPrefab(const EntityDefinition& definition)
 {
     Json::Value components = definition.json["components"];
     
@@ -54,35 +469,60 @@ nox::ecs::Factory::createEntity(const EntityId& id,
         extensionStack.pop();
     }
 
+    Prefab prefab;
+
     // Process children.
     const auto& children = components.get("Children", Json::nullValue);
     if (children != Json::nullValue)
     {
-        auto childrenComponent = std::move(this->parseChildren(id, children));
-        this->entityManager.assignComponent(id, component_type::CHILDREN, std::move(childrenComponent));
+        prefab.hasChildren = true;
+        for (const auto& item : children)
+        {
+            prefab.children.push_back(item.asString());
+        }
     }
 
     // Start creating the types. 
-    const auto componentNames = [](auto names) -> std::vector<std::string>
-    {
-        names.erase(std::remove_if(std::begin(names),
-                                   std::end(names),
-                                   [](const auto& item) 
-                                   { return item == "Children"; }),
-                    std::end(names));
-        
-        return names;
-    }(components.getMemberNames());
-    
+    const auto componentNames = components.getMemberNames();
     for (const auto& item : componentNames)
     {
-        auto& component = components[item];
-        const auto identifier = this->getTypeIdentifier(component, item);
+        if (item != "Children")
+        {
+            auto& component = components[item];
+            const auto identifier = this->getTypeIdentifier(component, item);
+            const auto prototype = this->entityManager.createPrototype(identifier, component);
+            prefab.components.push_back({ identifier, component, prototype });
+        }
+    }
 
-        this->entityManager.assignComponent(id,
-                                            identifier,
-                                            component);
-    } 
+    return prefab;
+}
+
+bool
+nox::ecs::Factory::extendsAny(const EntityDefinition& definition,
+                              const std::unordered_set<std::string>& names) const
+{
+    if (names.count(definition.name) != 0)
+    {
+        return true;
+    }
+
+    Json::Value extension = definition.json.get("extend", Json::nullValue);
+    while (extension.isNull() == false)
+    {
+        const auto extensionName = extension.asString();
+        if (names.count(extensionName) != 0)
+        {
+            return true;
+        }
+
+        const auto base = this->definitions.find(extensionName);
+        extension = (base != std::cend(this->definitions))
+                  ? base->second.json.get("extend", Json::nullValue)
+                  : Json::nullValue;
+    }
+
+    return false;
 }
 
 void
@@ -141,15 +581,11 @@ nox::ecs::Factory::createExtensionStack(const Json::Value& root)
     {
         const auto extensionName = extension.asString();
 
-        const auto& definition = std::find_if(std::cbegin(this->definitions),
-                                              std::cend(this->definitions), 
-                                              [&extensionName](const auto& item)
-                                              { return item.name == extensionName; });
-
+        const auto definition = this->definitions.find(extensionName);
         if (definition != std::cend(this->definitions))
         {
-            stack.push({definition->json});
-            extension = definition->json.get("extend", Json::nullValue);
+            stack.push({definition->second.json});
+            extension = definition->second.json.get("extend", Json::nullValue);
         }
         else
         {
@@ -160,22 +596,33 @@ nox::ecs::Factory::createExtensionStack(const Json::Value& root)
     return stack;
 }
 
-nox::ecs::Children
-nox::ecs::Factory::parseChildren(const EntityId& id, 
-                                 const Json::Value& children)
+std::vector<nox::ecs::Children>
+nox::ecs::Factory::parseChildren(const EntityId& firstId,
+                                 std::size_t count,
+                                 const std::vector<std::string>& children) const
 {
-    Children childrenComp(id, &entityManager);
+    std::vector<Children> childrenComps;
+    childrenComps.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        childrenComps.emplace_back(firstId + i, &entityManager);
+    }
+
     for (const auto& item : children)
     {
-        const auto childId = this->entityManager.createEntity(item.asString());
-        Parent parent(childId, &entityManager);
-        parent.parentId = id;
-        this->entityManager.assignComponent(childId, component_type::PARENT, std::move(parent));
+        const auto firstChildId = this->entityManager.createEntities(item, count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto childId = firstChildId + i;
+            Parent parent(childId, &entityManager);
+            parent.parentId = firstId + i;
+            this->entityManager.assignComponent(childId, component_type::PARENT, std::move(parent));
 
-        childrenComp.addChild(childId);
+            childrenComps[i].addChild(childId);
+        }
     }
 
-    return std::move(childrenComp);
+    return childrenComps;
 }
 
 nox::ecs::TypeIdentifier
@@ -1,11 +1,21 @@
 #ifndef NOX_ECS_FACTORY_H_
 #define NOX_ECS_FACTORY_H_
-#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stack>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <nox/ecs/Component.h>
 #include <nox/ecs/TypeIdentifier.h>
 #include <nox/ecs/component/Children.h>
+#include <nox/memory/MappedFile.h>
 
 #include <json/json.h>
 
@@ -24,6 +34,26 @@ namespace nox
         /**
          * @brief      Factory used to create entities based on json files. Non
          *             json based entities are created just through the manager.
+         *
+         *             Definitions are flattened into prefabs when they are
+         *             created, i.e. the extension chain is merged and the
+         *             component identifiers are parsed once, so creating an
+         *             entity is a hash lookup and a copy of the components.
+         *             Components with a clone operation, i.e. cloneable
+         *             ones, are initialized once into a prototype, which
+         *             every entity is cloned from.
+         *             Prototypes are only made for component types that are
+         *             registered before the definition is created.
+         *
+         *             Creating entities is thread-safe, and lock-free for
+         *             threads with a nox::thread::ThreadIndex, so components
+         *             can spawn entities concurrently during update. The
+         *             requests reference the json of the prefab instead of
+         *             copying it, and the Children and Parent components are
+         *             kept in per thread tables by the EntityManager. The
+         *             prefabs are published as an immutable map, which
+         *             createEntityDefinition replaces rather than changes,
+         *             so lookups never wait for a definition being loaded.
          */
         class Factory
         {
@@ -37,9 +67,20 @@ namespace nox
              */
             Factory(EntityManager& entityManager);
 
+            /**
+             * @brief      Type is not copyable.
+             */
+            Factory(const Factory&) = delete;
+
+            /**
+             * @brief      Type is not copyable.
+             */
+            Factory& operator=(const Factory&) = delete;
+
             /**
              * @brief      Creates an entity with the given id, based on the
              *             json definition with name == definitionName.
+             *             Function can be called concurrently.
              *
              * @param[in]  id              The id of the entity.
              * @param[in]  definitionName  The name of the json definition to
@@ -47,10 +88,15 @@ namespace nox
              */
             void 
             createEntity(const EntityId& id,
-                         const std::string& definitionName);
+                         const std::string& definitionName) const;
 
             /**
              * @brief      Creates entity definitions based on a json root.
+             *             If a definition with the same name already exists,
+             *             the existing one is kept. Function can be called
+             *             concurrently with itself and with creating
+             *             entities, but not with createStep, as it creates
+             *             prototypes in the component collections.
              *
              * @note       This function is a temp until support for
              *             nox-resources are added to the factory.
@@ -60,6 +106,84 @@ namespace nox
              */
             void 
             createEntityDefinition(const Json::Value& root);
+
+            /**
+             * @brief      Creates count entities with the ids [firstId,
+             *             firstId + count), based on the json definition with
+             *             name == definitionName. One creation request is
+             *             made per component type, rather than per entity.
+             *             Function can be called concurrently.
+             *
+             * @param[in]  firstId         The id of the first entity.
+             * @param[in]  count           The number of entities.
+             * @param[in]  definitionName  The name of the json definition to
+             *                             create the entities from.
+             */
+            void
+            createEntities(const EntityId& firstId,
+                           std::size_t count,
+                           const std::string& definitionName) const;
+
+            /**
+             * @brief      Value identifying the start of a compiled prefab
+             *             file, "NOXP".
+             */
+            static constexpr std::uint32_t MAGIC = 0x50584F4E;
+
+            /**
+             * @brief      Version of the compiled prefab format.
+             */
+            static constexpr std::uint32_t VERSION = 1;
+
+            /**
+             * @brief      Writes every prefab into a compiled file, which
+             *             loadCompiledDefinitions can create entities from
+             *             without parsing any json. The extension chains and
+             *             children are already resolved in the prefabs.
+             *
+             *             Components that are trivially copyable and have a
+             *             prototype are written as the bytes of the
+             *             prototype, which the loader clones from in place.
+             *             Other components are written as compact json, and
+             *             parsed when the file is loaded.
+             *
+             * @note       Values are written in native byte order, and the
+             *             component bytes and type identifiers are only
+             *             valid for the same build of the components, so the
+             *             file should be compiled per target platform.
+             *
+             * @param      stream  The stream to write to, must be opened in
+             *                     binary mode. Prototypes are aligned
+             *                     relative to the start of the stream, as
+             *                     given by tellp, and
+             *                     loadCompiledDefinitions expects the
+             *                     compiled data at the start of the file.
+             *
+             * @return     true if everything was written.
+             */
+            bool
+            compileDefinitions(std::ostream& stream);
+
+            /**
+             * @brief      Maps a file written by compileDefinitions and
+             *             publishes its prefabs. The file stays mapped for the
+             *             lifetime of the factory. Like
+             *             createEntityDefinition, existing prefabs with the
+             *             same name are kept, and the same threading rules
+             *             apply.
+             *
+             * @note       Json definitions cannot extend the loaded prefabs,
+             *             as their json is not available.
+             *
+             * @param[in]  path  The path of the compiled file.
+             *
+             * @return     true if the file was loaded. False if it could not
+             *             be mapped, is malformed, or a component written as
+             *             bytes does not match the registered type. Nothing
+             *             is published in that case.
+             */
+            bool
+            loadCompiledDefinitions(const std::string& path);
         
         private:
 
@@ -76,19 +200,90 @@ namespace nox
                 std::string getFullName() const;
             };
 
+            /**
+             * @brief      A component of a prefab, with its identifier
+             *             already parsed.
+             */
+            struct PrefabComponent
+            {
+                TypeIdentifier identifier;
+                Json::Value json;
+
+                /**
+                 * @brief      Prototype initialized with json, nullptr if
+                 *             the component must be initialized per entity.
+                 */
+                const Component* prototype;
+            };
+
+            /**
+             * @brief      A definition with its extension chain merged in,
+             *             ready to create entities from.
+             */
+            struct Prefab
+            {
+                /**
+                 * @brief      Whether the definition has a Children entry,
+                 *             even an empty one gets a Children component.
+                 */
+                bool hasChildren{false};
+
+                /**
+                 * @brief      Definition names of the children to create.
+                 */
+                std::vector<std::string> children{};
+
+                /**
+                 * @brief      The components, in the order they are assigned.
+                 */
+                std::vector<PrefabComponent> components{};
+            };
+
             using JsonStack = std::stack<Json::Value, std::vector<Json::Value>>;
 
             /**
-             * @brief      Creates an entity with the given id based on the
-             *             definition parameter.
+             * @brief      Map from definition name to prefab, never changed
+             *             after it is published.
+             */
+            using PrefabMap = std::unordered_map<std::string, const Prefab*>;
+
+            /**
+             * @brief      Creates count entities with the ids [firstId,
+             *             firstId + count) based on the prefab parameter.
              *
-             * @param[in]  id          The id of the entity to create.
-             * @param[in]  definition  The definition object holding all
-             *                         relevant information.
+             * @param[in]  firstId  The id of the first entity to create.
+             * @param[in]  count    The number of entities to create.
+             * @param[in]  prefab   The flattened definition to create the
+             *                      entities from.
              */
             void 
-            createEntity(const EntityId& id,
-                         const EntityDefinition& definition);
+            createEntities(const EntityId& firstId,
+                           std::size_t count,
+                           const Prefab& prefab) const;
+
+            /**
+             * @brief      Merges the extension chain of the definition and
+             *             parses the result into a prefab.
+             *
+             * @param[in]  definition  The definition to flatten.
+             *
+             * @return     The flattened definition.
+             */
+            Prefab
+            createPrefab(const EntityDefinition& definition);
+
+            /**
+             * @brief      Checks if the definition, or one of the definitions
+             *             it extends, has one of the given names.
+             *
+             * @param[in]  definition  The definition to check.
+             * @param[in]  names       The names to look for.
+             *
+             * @return     true if the extension chain contains one of names.
+             */
+            bool
+            extendsAny(const EntityDefinition& definition,
+                       const std::unordered_set<std::string>& names) const;
 
             /**
              * @brief      Extends the json values within destination based on source.
@@ -121,18 +316,23 @@ namespace nox
             createExtensionStack(const Json::Value& root);
 
             /**
-             * @brief      Creates a children component based on the values in children.
-             *             The function also creates all the children, and assigns them
-             *             a parent component allowing them to get back to their parent.
+             * @brief      Creates a children component for each of the parents
+             *             [firstId, firstId + count), based on the values in
+             *             children. The function also creates all the children,
+             *             one batch per definition, and assigns them a parent
+             *             component allowing them to get back to their parent.
              *             
-             * @param[in]  id        The id of the parent entity.
-             * @param[in]  children  The json value holding all the children.
+             * @param[in]  firstId   The id of the first parent entity.
+             * @param[in]  count     The number of parent entities.
+             * @param[in]  children  The definition names of all the children.
              *
-             * @return     A children component with all children added in it.
+             * @return     A children component per parent, with all its
+             *             children added in it.
              */
-            Children
-            parseChildren(const EntityId& id,
-                          const Json::Value& children);
+            std::vector<Children>
+            parseChildren(const EntityId& firstId,
+                          std::size_t count,
+                          const std::vector<std::string>& children) const;
            
             /**
              * @brief      Returns the TypeIdentifier within the value, or just 
@@ -147,7 +347,36 @@ namespace nox
             getTypeIdentifier(const Json::Value& value, const std::string& name);
 
             EntityManager& entityManager;
-            std::vector<EntityDefinition> definitions;
+
+            /**
+             * @brief      Serializes createEntityDefinition, and guards all
+             *             members below except prefabs.
+             */
+            std::mutex definitionMutex{};
+            std::unordered_map<std::string, EntityDefinition> definitions{};
+
+            /**
+             * @brief      Storage of all prefabs, std::deque keeps them in
+             *             place. Replaced prefabs are kept, as concurrent
+             *             creations might still use them.
+             */
+            std::deque<Prefab> prefabStorage{};
+
+            /**
+             * @brief      The loaded compiled files, which prototypes of the
+             *             loaded prefabs point into.
+             */
+            std::vector<nox::memory::MappedFile> compiledFiles{};
+
+            /**
+             * @brief      Every published map, kept for the same reason.
+             */
+            std::vector<std::unique_ptr<const PrefabMap>> prefabMaps{};
+
+            /**
+             * @brief      The current map, read without locking.
+             */
+            std::atomic<const PrefabMap*> prefabs{nullptr};
         };
     }
 }
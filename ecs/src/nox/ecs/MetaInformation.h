@@ -63,6 +63,38 @@ namespace nox
              */
             operation::ConstructOp construct{};
 
+            /**
+             * @brief      Operation indicating how the components are copied
+             *             from a prototype. If set, the factory initializes
+             *             each component of a definition once, and clones
+             *             that prototype for every entity created from the
+             *             definition. Only set by createMetaInformation for
+             *             types that opt in through Component::cloneable,
+             *             must be nullptr if initialize depends on the
+             *             entity, or has side effects.
+             */
+            operation::CloneOp clone{};
+
+            /**
+             * @brief      Whether the type is trivially copyable, i.e. its
+             *             bytes can be written to a file and used as is when
+             *             read back in, as long as the layout is the same.
+             */
+            bool triviallyCopyable{false};
+
+            /**
+             * @brief      Operation indicating how the components are written
+             *             into a snapshot. Only used if the type is not
+             *             trivially copyable, those are written as bytes.
+             */
+            operation::SerializeOp serialize{};
+
+            /**
+             * @brief      Operation indicating how the components are read
+             *             back from a snapshot, see serialize.
+             */
+            operation::DeserializeOp deserialize{};
+
             /**
              * @brief      Operation indicating how the components shall be
              *             destructed.
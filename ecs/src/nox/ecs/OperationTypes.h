@@ -1,5 +1,6 @@
 #ifndef NOX_ECS_OPERATIONTYPES_H_
 #define NOX_ECS_OPERATIONTYPES_H_
+#include <iosfwd>
 #include <memory>
 
 #include <nox/common/types.h>
@@ -75,6 +76,23 @@ namespace nox
                                         const EntityId& id,
                                         EntityManager* manager);
 
+            /**
+             * @brief      Function used to construct a single element as a
+             *             copy of a prototype.
+             *
+             * @param      component  the component to construct.
+             * @param      prototype  the component to copy.
+             * @param      id         the id to give the component.
+             * @param      manager    the manager to give the component.
+             *
+             * @warning    Casting to the correct component type is the users
+             *             responsibility.
+             */
+            using CloneOp = void(*)(Component* component,
+                                    const Component* prototype,
+                                    const EntityId& id,
+                                    EntityManager* manager);
+
             /**
              * @brief      Function used for updating a range of elements.
              *
@@ -103,6 +121,32 @@ namespace nox
             using InitializeOp = void(*)(Component* component,
                                          const Json::Value& value);
 
+            /**
+             * @brief      Function used for writing a single element to a
+             *             binary stream.
+             *
+             * @param      component  the component to write.
+             * @param      stream     the stream to write to.
+             *
+             * @warning    Casting to the correct component type is the users
+             *             responsibility.
+             */
+            using SerializeOp = void(*)(const Component* component,
+                                        std::ostream& stream);
+
+            /**
+             * @brief      Function used for reading a single element from a
+             *             binary stream, written by the SerializeOp.
+             *
+             * @param      component  the constructed component to read into.
+             * @param      stream     the stream to read from.
+             *
+             * @warning    Casting to the correct component type is the users
+             *             responsibility.
+             */
+            using DeserializeOp = void(*)(Component* component,
+                                          std::istream& stream);
+
             /**
              * @brief      Function to be called on events coming from the NOX
              *             event system.
@@ -0,0 +1,208 @@
+#include <nox/ecs/TraceRecorder.h>
+
+#include <algorithm>
+
+#include <nox/ecs/component/Children.h>
+#include <nox/ecs/component/Parent.h>
+#include <nox/ecs/Event.h>
+
+constexpr std::uint32_t nox::ecs::TraceRecorder::MAGIC;
+constexpr std::uint32_t nox::ecs::TraceRecorder::VERSION;
+
+nox::ecs::TraceRecorder::TraceRecorder(std::ostream& stream)
+    : stream(stream)
+{
+    this->writeUint32(MAGIC);
+    this->writeUint32(VERSION);
+}
+
+std::size_t&
+nox::ecs::TraceRecorder::Scope::threadDepth()
+{
+    thread_local std::size_t depth{0};
+    return depth;
+}
+
+void
+nox::ecs::TraceRecorder::recordDefinition(const Json::Value& root)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    Json::FastWriter writer;
+    this->writeRecord(Record::ENTITY_DEFINITION);
+    this->writeString(writer.write(root));
+}
+
+void
+nox::ecs::TraceRecorder::recordEntity(Record record,
+                                      const EntityId& id)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->writeRecord(record);
+    this->writeUint64(id);
+}
+
+void
+nox::ecs::TraceRecorder::recordEntity(const EntityId& id,
+                                      const std::string& definitionName)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->writeRecord(Record::CREATE_ENTITY_FROM_DEFINITION);
+    this->writeUint64(id);
+    this->writeString(definitionName);
+}
+
+void
+nox::ecs::TraceRecorder::recordEntities(const EntityId& firstId,
+                                        std::size_t count,
+                                        const std::string& definitionName)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->writeRecord(Record::CREATE_ENTITIES_FROM_DEFINITION);
+    this->writeUint64(firstId);
+    this->writeUint64(count);
+    this->writeString(definitionName);
+}
+
+void
+nox::ecs::TraceRecorder::recordComponent(Record record,
+                                         const EntityId& id,
+                                         const TypeIdentifier& identifier)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->writeComponent(record, id, identifier);
+}
+
+void
+nox::ecs::TraceRecorder::recordComponent(const EntityId& id,
+                                         const TypeIdentifier& identifier,
+                                         const Json::Value& value)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    Json::FastWriter writer;
+    this->writeComponent(Record::ASSIGN_COMPONENT_JSON, id, identifier);
+    this->writeString(writer.write(value));
+}
+
+void
+nox::ecs::TraceRecorder::recordComponent(const EntityId& id,
+                                         const TypeIdentifier& identifier,
+                                         const Children& children)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->writeComponent(Record::ASSIGN_CHILDREN, id, identifier);
+    this->writeUint32(static_cast<std::uint32_t>(children.size()));
+    for (std::size_t i = 0; i < children.size(); ++i)
+    {
+        this->writeUint64(children[i]);
+    }
+}
+
+void
+nox::ecs::TraceRecorder::recordComponent(const EntityId& id,
+                                         const TypeIdentifier& identifier,
+                                         const Parent& parent)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->writeComponent(Record::ASSIGN_PARENT, id, identifier);
+    this->writeUint64(parent.parentId);
+}
+
+void
+nox::ecs::TraceRecorder::recordEvent(const Event& event)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->writeRecord(Record::SEND_ENTITY_EVENT);
+    this->writeUint64(event.getType().getValue());
+    this->writeUint64(event.getSender());
+    this->writeUint64(event.getReceiver());
+
+    this->writeUint32(event.payloadSize);
+    this->writeUint32(event.payloadAlignment);
+    this->write(event.payload, event.payloadSize);
+
+    const auto first = event.arguments;
+    const auto last = event.arguments + event.argumentCount;
+    const auto copyableCount = std::count_if(first, last,
+                                             [](const auto& argument)
+                                             { return argument.getSize() != 0; });
+
+    this->writeUint32(static_cast<std::uint32_t>(copyableCount));
+    for (auto argument = first; argument != last; ++argument)
+    {
+        if (argument->getSize() != 0)
+        {
+            this->writeUint64(argument->getIdentifier().getValue());
+            this->writeUint32(static_cast<std::uint32_t>(argument->getSize()));
+            this->writeUint32(static_cast<std::uint32_t>(argument->getAlignment()));
+            this->write(argument->value(), argument->getSize());
+        }
+    }
+}
+
+void
+nox::ecs::TraceRecorder::recordStep(Record record)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->writeRecord(record);
+}
+
+void
+nox::ecs::TraceRecorder::recordStep(Record record,
+                                    const nox::Duration& deltaTime)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->writeRecord(record);
+    this->writeUint64(static_cast<std::uint64_t>(deltaTime.count()));
+}
+
+void
+nox::ecs::TraceRecorder::flush()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stream.flush();
+}
+
+void
+nox::ecs::TraceRecorder::writeComponent(Record record,
+                                        const EntityId& id,
+                                        const TypeIdentifier& identifier)
+{
+    this->writeRecord(record);
+    this->writeUint64(id);
+    this->writeUint64(identifier.getValue());
+}
+
+void
+nox::ecs::TraceRecorder::write(const void* data, std::size_t size)
+{
+    if (size != 0)
+    {
+        this->stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+}
+
+void
+nox::ecs::TraceRecorder::writeRecord(Record record)
+{
+    const auto value = static_cast<std::uint8_t>(record);
+    this->write(&value, sizeof(value));
+}
+
+void
+nox::ecs::TraceRecorder::writeUint32(std::uint32_t value)
+{
+    this->write(&value, sizeof(value));
+}
+
+void
+nox::ecs::TraceRecorder::writeUint64(std::uint64_t value)
+{
+    this->write(&value, sizeof(value));
+}
+
+void
+nox::ecs::TraceRecorder::writeString(const std::string& value)
+{
+    this->writeUint32(static_cast<std::uint32_t>(value.size()));
+    this->write(value.data(), value.size());
+}
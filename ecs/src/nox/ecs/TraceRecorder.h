@@ -0,0 +1,368 @@
+#ifndef NOX_ECS_TRACERECORDER_H_
+#define NOX_ECS_TRACERECORDER_H_
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+#include <nox/common/types.h>
+#include <nox/ecs/EntityId.h>
+#include <nox/ecs/TypeIdentifier.h>
+
+#include <json/json.h>
+
+namespace nox
+{
+    namespace ecs
+    {
+        class Children;
+        class Event;
+        class Parent;
+
+        /**
+         * @brief      Records the requests given to an EntityManager into a
+         *             compact binary trace, which can be played back into
+         *             another EntityManager through a TraceReplayer. Used for
+         *             reproducing bugs and for comparing performance changes
+         *             against the exact same workload.
+         *
+         *             Only the outermost request on each thread is recorded,
+         *             calls made while executing a recorded request, like the
+         *             factory assigning components, are reproduced by
+         *             replaying that request. While a step, or one of its
+         *             phases, is executing, no other requests are recorded on
+         *             any thread, as they are made by the components running
+         *             on the workers and reproduced by replaying the step. The
+         *             replay is therefore only deterministic if the
+         *             components are.
+         *
+         *             Logic events are not recorded, neither are entity event
+         *             arguments that are not trivially copyable.
+         *
+         * @warning    Requests made concurrently from several threads are
+         *             recorded in the order they reach the recorder, which is
+         *             not necessarily the order they were executed in. Requests
+         *             made from outside the EntityManager while it is stepping
+         *             are not recorded.
+         *
+         * @note       Values are written in native byte order, so a trace can
+         *             only be replayed on a platform with the same byte order
+         *             and clock resolution.
+         */
+        class TraceRecorder
+        {
+        public:
+            /**
+             * @brief      The kind of each record within the trace.
+             */
+            enum class Record : std::uint8_t
+            {
+                ENTITY_DEFINITION,
+                CREATE_ENTITY,
+                CREATE_ENTITY_FROM_DEFINITION,
+                ASSIGN_COMPONENT,
+                ASSIGN_COMPONENT_JSON,
+                ASSIGN_CHILDREN,
+                ASSIGN_PARENT,
+                REMOVE_COMPONENT,
+                AWAKE_COMPONENT,
+                ACTIVATE_COMPONENT,
+                DEACTIVATE_COMPONENT,
+                HIBERNATE_COMPONENT,
+                REMOVE_ENTITY,
+                AWAKE_ENTITY,
+                ACTIVATE_ENTITY,
+                DEACTIVATE_ENTITY,
+                HIBERNATE_ENTITY,
+                SEND_ENTITY_EVENT,
+                STEP,
+                ADVANCE_CHANGE_TICK,
+                DISTRIBUTE_LOGIC_EVENTS,
+                UPDATE_STEP,
+                DISTRIBUTE_ENTITY_EVENTS,
+                DEACTIVATE_STEP,
+                HIBERNATE_STEP,
+                REMOVE_STEP,
+                CREATE_STEP,
+                AWAKE_STEP,
+                ACTIVATE_STEP,
+                CREATE_ENTITIES_FROM_DEFINITION,
+            };
+
+            /**
+             * @brief      Value identifying the start of a trace, "NOXT".
+             */
+            static constexpr std::uint32_t MAGIC = 0x54584F4E;
+
+            /**
+             * @brief      Version of the trace format.
+             */
+            static constexpr std::uint32_t VERSION = 1;
+
+            /**
+             * @brief      Marks the duration of a request. Records made through
+             *             the scope are only written if no other scope is
+             *             active on the calling thread, and the recorder is not
+             *             stepping, see the class description.
+             */
+            class Scope
+            {
+            public:
+                /**
+                 * @brief      Enters a scope of the recorder.
+                 *
+                 * @param      recorder  The recorder, nullptr if recording is
+                 *                       turned off.
+                 * @param[in]  step      true if the request is a step, or one
+                 *                       of its phases, suppressing requests
+                 *                       from all threads until it is left.
+                 */
+                inline explicit Scope(TraceRecorder* recorder, bool step = false);
+
+                /**
+                 * @brief      Type is not copyable.
+                 */
+                Scope(const Scope&) = delete;
+
+                /**
+                 * @brief      Type is not copyable.
+                 */
+                Scope& operator=(const Scope&) = delete;
+
+                /**
+                 * @brief      Leaves the scope.
+                 */
+                inline ~Scope();
+
+                /**
+                 * @brief      Checks if the request should be recorded.
+                 *
+                 * @return     true if there is a recorder, this is the
+                 *             outermost scope on the thread, and the recorder
+                 *             was not already stepping.
+                 */
+                inline explicit operator bool() const;
+
+                /**
+                 * @brief      Gives access to the recorder.
+                 */
+                inline TraceRecorder* operator->() const;
+
+            private:
+                /**
+                 * @brief      Returns the number of active scopes on the
+                 *             calling thread.
+                 */
+                static std::size_t&
+                threadDepth();
+
+                TraceRecorder* recorder;
+                bool outermost{false};
+                bool ownsStepping{false};
+            };
+
+            /**
+             * @brief      Creates the recorder and writes the trace header.
+             *
+             * @param      stream  The stream to write the trace to, must be
+             *                     opened in binary mode and outlive the
+             *                     recorder.
+             */
+            explicit TraceRecorder(std::ostream& stream);
+
+            /**
+             * @brief      Type is not copyable.
+             */
+            TraceRecorder(const TraceRecorder&) = delete;
+
+            /**
+             * @brief      Type is not copyable.
+             */
+            TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+            /**
+             * @brief      Records an entity definition.
+             *
+             * @param[in]  root  The json value holding the definitions.
+             */
+            void
+            recordDefinition(const Json::Value& root);
+
+            /**
+             * @brief      Records a request only concerning an entity, i.e.
+             *             CREATE_ENTITY or one of the *_ENTITY records.
+             *
+             * @param[in]  record  The kind of request.
+             * @param[in]  id      The id of the entity.
+             */
+            void
+            recordEntity(Record record,
+                         const EntityId& id);
+
+            /**
+             * @brief      Records the creation of an entity from a definition.
+             *
+             * @param[in]  id              The id given to the entity.
+             * @param[in]  definitionName  The name of the definition.
+             */
+            void
+            recordEntity(const EntityId& id,
+                         const std::string& definitionName);
+
+            /**
+             * @brief      Records the creation of a range of entities from a
+             *             definition.
+             *
+             * @param[in]  firstId         The id given to the first entity.
+             * @param[in]  count           The number of entities.
+             * @param[in]  definitionName  The name of the definition.
+             */
+            void
+            recordEntities(const EntityId& firstId,
+                           std::size_t count,
+                           const std::string& definitionName);
+
+            /**
+             * @brief      Records a request concerning a component, i.e.
+             *             ASSIGN_COMPONENT or one of the *_COMPONENT records.
+             *
+             * @param[in]  record      The kind of request.
+             * @param[in]  id          The id of the entity.
+             * @param[in]  identifier  The type of the component.
+             */
+            void
+            recordComponent(Record record,
+                            const EntityId& id,
+                            const TypeIdentifier& identifier);
+
+            /**
+             * @brief      Records a component assigned with a json value.
+             *
+             * @param[in]  id          The id of the entity.
+             * @param[in]  identifier  The type of the component.
+             * @param[in]  value       The value to initialize the component with.
+             */
+            void
+            recordComponent(const EntityId& id,
+                            const TypeIdentifier& identifier,
+                            const Json::Value& value);
+
+            /**
+             * @brief      Records an assigned children component.
+             *
+             * @param[in]  id          The id of the entity.
+             * @param[in]  identifier  The type of the component.
+             * @param[in]  children    The component, before it is moved from.
+             */
+            void
+            recordComponent(const EntityId& id,
+                            const TypeIdentifier& identifier,
+                            const Children& children);
+
+            /**
+             * @brief      Records an assigned parent component.
+             *
+             * @param[in]  id          The id of the entity.
+             * @param[in]  identifier  The type of the component.
+             * @param[in]  parent      The component, before it is moved from.
+             */
+            void
+            recordComponent(const EntityId& id,
+                            const TypeIdentifier& identifier,
+                            const Parent& parent);
+
+            /**
+             * @brief      Records a sent entity event, with its payload and
+             *             the arguments that are trivially copyable.
+             *
+             * @param[in]  event  The event, before it is moved from.
+             */
+            void
+            recordEvent(const Event& event);
+
+            /**
+             * @brief      Records a step, or one of its phases.
+             *
+             * @param[in]  record  The kind of step.
+             */
+            void
+            recordStep(Record record);
+
+            /**
+             * @brief      Records a step, or one of its phases, taking a
+             *             delta time.
+             *
+             * @param[in]  record     The kind of step.
+             * @param[in]  deltaTime  The delta time given to the step.
+             */
+            void
+            recordStep(Record record,
+                       const nox::Duration& deltaTime);
+
+            /**
+             * @brief      Flushes the underlying stream.
+             */
+            void
+            flush();
+
+        private:
+            /**
+             * @brief      Writes the header shared by all component records.
+             */
+            void
+            writeComponent(Record record,
+                           const EntityId& id,
+                           const TypeIdentifier& identifier);
+
+            /**
+             * @brief      Writes size raw bytes to the stream.
+             */
+            void
+            write(const void* data, std::size_t size);
+
+            /**
+             * @brief      Writes the kind of a record.
+             */
+            void
+            writeRecord(Record record);
+
+            /**
+             * @brief      Writes a 32 bit value in native byte order.
+             */
+            void
+            writeUint32(std::uint32_t value);
+
+            /**
+             * @brief      Writes a 64 bit value in native byte order.
+             */
+            void
+            writeUint64(std::uint64_t value);
+
+            /**
+             * @brief      Writes a string as its 32 bit length followed by
+             *             its characters.
+             */
+            void
+            writeString(const std::string& value);
+
+            std::ostream& stream;
+
+            /**
+             * @brief      Keeps records from different threads from
+             *             interleaving.
+             */
+            std::mutex mutex{};
+
+            /**
+             * @brief      Set while a step, or one of its phases, is executing.
+             */
+            std::atomic<bool> stepping{false};
+        };
+    }
+}
+
+#include <nox/ecs/TraceRecorder.ipp>
+
+#endif
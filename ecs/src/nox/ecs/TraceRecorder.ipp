@@ -0,0 +1,36 @@
+nox::ecs::TraceRecorder::Scope::Scope(TraceRecorder* recorder, bool step)
+    : recorder(recorder)
+{
+    if (this->recorder)
+    {
+        this->outermost = threadDepth()++ == 0 && !this->recorder->stepping.load(std::memory_order_acquire);
+        if (this->outermost && step)
+        {
+            this->recorder->stepping.store(true, std::memory_order_release);
+            this->ownsStepping = true;
+        }
+    }
+}
+
+nox::ecs::TraceRecorder::Scope::~Scope()
+{
+    if (this->recorder)
+    {
+        --threadDepth();
+        if (this->ownsStepping)
+        {
+            this->recorder->stepping.store(false, std::memory_order_release);
+        }
+    }
+}
+
+nox::ecs::TraceRecorder::Scope::operator bool() const
+{
+    return this->outermost;
+}
+
+nox::ecs::TraceRecorder*
+nox::ecs::TraceRecorder::Scope::operator->() const
+{
+    return this->recorder;
+}
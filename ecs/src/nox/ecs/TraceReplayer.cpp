@@ -0,0 +1,348 @@
+#include <nox/ecs/TraceReplayer.h>
+
+#include <nox/ecs/EntityManager.h>
+#include <nox/ecs/TraceRecorder.h>
+#include <nox/memory/alignment.h>
+
+namespace
+{
+    namespace local
+    {
+        using Record = nox::ecs::TraceRecorder::Record;
+
+        bool
+        isValidPayload(std::uint32_t size, std::uint32_t alignment)
+        {
+            using Allocator = nox::ecs::Event::ArgumentAllocator;
+            return size > 0 &&
+                   nox::memory::isValidAlignment(alignment) &&
+                   size + Allocator::getWorstCasePadding(alignment) <= Allocator::MAX_SIZE;
+        }
+    }
+}
+
+nox::ecs::TraceReplayer::TraceReplayer(EntityManager& entityManager)
+    : entityManager(entityManager)
+{
+
+}
+
+bool
+nox::ecs::TraceReplayer::replay(std::istream& stream)
+{
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    if (!this->read(stream, &magic, sizeof(magic)) ||
+        !this->read(stream, &version, sizeof(version)) ||
+        magic != TraceRecorder::MAGIC ||
+        version != TraceRecorder::VERSION)
+    {
+        return false;
+    }
+
+    std::uint8_t record = 0;
+    while (this->read(stream, &record, sizeof(record)))
+    {
+        if (!this->replayRecord(stream, record))
+        {
+            return false;
+        }
+    }
+
+    return stream.eof();
+}
+
+nox::ecs::EntityId
+nox::ecs::TraceReplayer::getReplayedId(const EntityId& recordedId) const
+{
+    const auto itr = this->entityIds.find(recordedId);
+    return (itr != this->entityIds.cend()) ? itr->second : recordedId;
+}
+
+bool
+nox::ecs::TraceReplayer::replayRecord(std::istream& stream, std::uint8_t record)
+{
+    using local::Record;
+
+    std::uint64_t id = 0;
+    std::uint64_t type = 0;
+    std::string text;
+
+    switch (static_cast<Record>(record))
+    {
+        case Record::ENTITY_DEFINITION:
+        {
+            Json::Reader reader;
+            Json::Value root;
+            if (!this->readString(stream, text) || !reader.parse(text, root))
+            {
+                return false;
+            }
+            this->entityManager.createEntityDefinition(root);
+            return true;
+        }
+
+        case Record::CREATE_ENTITY:
+            if (!this->read(stream, &id, sizeof(id)))
+            {
+                return false;
+            }
+            this->entityIds[id] = this->entityManager.createEntity();
+            return true;
+
+        case Record::CREATE_ENTITY_FROM_DEFINITION:
+            if (!this->read(stream, &id, sizeof(id)) || !this->readString(stream, text))
+            {
+                return false;
+            }
+            this->entityIds[id] = this->entityManager.createEntity(text);
+            return true;
+
+        case Record::CREATE_ENTITIES_FROM_DEFINITION:
+        {
+            std::uint64_t count = 0;
+            if (!this->read(stream, &id, sizeof(id)) ||
+                !this->read(stream, &count, sizeof(count)) ||
+                !this->readString(stream, text))
+            {
+                return false;
+            }
+
+            const auto firstId = this->entityManager.createEntities(text, static_cast<std::size_t>(count));
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                this->entityIds[id + i] = firstId + i;
+            }
+            return true;
+        }
+
+        case Record::REMOVE_ENTITY:
+        case Record::AWAKE_ENTITY:
+        case Record::ACTIVATE_ENTITY:
+        case Record::DEACTIVATE_ENTITY:
+        case Record::HIBERNATE_ENTITY:
+        {
+            if (!this->read(stream, &id, sizeof(id)))
+            {
+                return false;
+            }
+
+            const auto replayedId = this->getReplayedId(id);
+            switch (static_cast<Record>(record))
+            {
+                case Record::REMOVE_ENTITY: this->entityManager.removeEntity(replayedId); break;
+                case Record::AWAKE_ENTITY: this->entityManager.awakeEntity(replayedId); break;
+                case Record::ACTIVATE_ENTITY: this->entityManager.activateEntity(replayedId); break;
+                case Record::DEACTIVATE_ENTITY: this->entityManager.deactivateEntity(replayedId); break;
+                default: this->entityManager.hibernateEntity(replayedId); break;
+            }
+            return true;
+        }
+
+        case Record::ASSIGN_COMPONENT:
+        case Record::ASSIGN_COMPONENT_JSON:
+        case Record::ASSIGN_CHILDREN:
+        case Record::ASSIGN_PARENT:
+        case Record::REMOVE_COMPONENT:
+        case Record::AWAKE_COMPONENT:
+        case Record::ACTIVATE_COMPONENT:
+        case Record::DEACTIVATE_COMPONENT:
+        case Record::HIBERNATE_COMPONENT:
+        {
+            if (!this->read(stream, &id, sizeof(id)) || !this->read(stream, &type, sizeof(type)))
+            {
+                return false;
+            }
+
+            const auto replayedId = this->getReplayedId(id);
+            const TypeIdentifier identifier(static_cast<std::size_t>(type));
+            switch (static_cast<Record>(record))
+            {
+                case Record::ASSIGN_COMPONENT:
+                    this->entityManager.assignComponent(replayedId, identifier);
+                    break;
+
+                case Record::ASSIGN_COMPONENT_JSON:
+                {
+                    Json::Reader reader;
+                    Json::Value value;
+                    if (!this->readString(stream, text) || !reader.parse(text, value))
+                    {
+                        return false;
+                    }
+                    this->entityManager.assignComponent(replayedId, identifier, value);
+                    break;
+                }
+
+                case Record::ASSIGN_CHILDREN:
+                {
+                    std::uint32_t count = 0;
+                    if (!this->read(stream, &count, sizeof(count)))
+                    {
+                        return false;
+                    }
+
+                    Children children{replayedId, &this->entityManager};
+                    for (std::uint32_t i = 0; i < count; ++i)
+                    {
+                        std::uint64_t childId = 0;
+                        if (!this->read(stream, &childId, sizeof(childId)))
+                        {
+                            return false;
+                        }
+                        children.addChild(this->getReplayedId(childId));
+                    }
+                    this->entityManager.assignComponent(replayedId, identifier, std::move(children));
+                    break;
+                }
+
+                case Record::ASSIGN_PARENT:
+                {
+                    std::uint64_t parentId = 0;
+                    if (!this->read(stream, &parentId, sizeof(parentId)))
+                    {
+                        return false;
+                    }
+
+                    Parent parent{replayedId, &this->entityManager};
+                    parent.parentId = this->getReplayedId(parentId);
+                    this->entityManager.assignComponent(replayedId, identifier, std::move(parent));
+                    break;
+                }
+
+                case Record::REMOVE_COMPONENT: this->entityManager.removeComponent(replayedId, identifier); break;
+                case Record::AWAKE_COMPONENT: this->entityManager.awakeComponent(replayedId, identifier); break;
+                case Record::ACTIVATE_COMPONENT: this->entityManager.activateComponent(replayedId, identifier); break;
+                case Record::DEACTIVATE_COMPONENT: this->entityManager.deactivateComponent(replayedId, identifier); break;
+                default: this->entityManager.hibernateComponent(replayedId, identifier); break;
+            }
+            return true;
+        }
+
+        case Record::SEND_ENTITY_EVENT:
+            return this->replayEvent(stream);
+
+        case Record::STEP:
+        case Record::UPDATE_STEP:
+        {
+            std::uint64_t ticks = 0;
+            if (!this->read(stream, &ticks, sizeof(ticks)))
+            {
+                return false;
+            }
+
+            const nox::Duration deltaTime(static_cast<nox::Duration::rep>(ticks));
+            if (static_cast<Record>(record) == Record::STEP)
+            {
+                this->entityManager.step(deltaTime);
+            }
+            else
+            {
+                this->entityManager.updateStep(deltaTime);
+            }
+            return true;
+        }
+
+        case Record::ADVANCE_CHANGE_TICK: this->entityManager.advanceChangeTick(); return true;
+        case Record::DISTRIBUTE_LOGIC_EVENTS: this->entityManager.distributeLogicEvents(); return true;
+        case Record::DISTRIBUTE_ENTITY_EVENTS: this->entityManager.distributeEntityEvents(); return true;
+        case Record::DEACTIVATE_STEP: this->entityManager.deactivateStep(); return true;
+        case Record::HIBERNATE_STEP: this->entityManager.hibernateStep(); return true;
+        case Record::REMOVE_STEP: this->entityManager.removeStep(); return true;
+        case Record::CREATE_STEP: this->entityManager.createStep(); return true;
+        case Record::AWAKE_STEP: this->entityManager.awakeStep(); return true;
+        case Record::ACTIVATE_STEP: this->entityManager.activateStep(); return true;
+    }
+
+    return false;
+}
+
+bool
+nox::ecs::TraceReplayer::replayEvent(std::istream& stream)
+{
+    std::uint64_t type = 0;
+    std::uint64_t sender = 0;
+    std::uint64_t receiver = 0;
+    std::uint32_t payloadSize = 0;
+    std::uint32_t payloadAlignment = 0;
+    if (!this->read(stream, &type, sizeof(type)) ||
+        !this->read(stream, &sender, sizeof(sender)) ||
+        !this->read(stream, &receiver, sizeof(receiver)) ||
+        !this->read(stream, &payloadSize, sizeof(payloadSize)) ||
+        !this->read(stream, &payloadAlignment, sizeof(payloadAlignment)))
+    {
+        return false;
+    }
+
+    auto event = this->entityManager.createEntityEvent(static_cast<std::size_t>(type),
+                                                       this->getReplayedId(sender),
+                                                       this->getReplayedId(receiver));
+
+    // The payload is owned by the event as soon as it is allocated, so a failed read needs no cleanup.
+    if (payloadSize != 0)
+    {
+        if (!local::isValidPayload(payloadSize, payloadAlignment))
+        {
+            return false;
+        }
+
+        event.payload = static_cast<nox::memory::Byte*>(event.getAllocator().allocate(payloadSize,
+                                                                                       payloadAlignment));
+        event.payloadSize = payloadSize;
+        event.payloadAlignment = payloadAlignment;
+        if (!this->read(stream, event.payload, payloadSize))
+        {
+            return false;
+        }
+    }
+
+    std::uint32_t argumentCount = 0;
+    if (!this->read(stream, &argumentCount, sizeof(argumentCount)))
+    {
+        return false;
+    }
+
+    for (std::uint32_t i = 0; i < argumentCount; ++i)
+    {
+        std::uint64_t identifier = 0;
+        std::uint32_t size = 0;
+        std::uint32_t alignment = 0;
+        if (!this->read(stream, &identifier, sizeof(identifier)) ||
+            !this->read(stream, &size, sizeof(size)) ||
+            !this->read(stream, &alignment, sizeof(alignment)) ||
+            !local::isValidPayload(size, alignment))
+        {
+            return false;
+        }
+
+        auto payload = static_cast<nox::memory::Byte*>(event.getAllocator().allocate(size, alignment));
+        if (!this->read(stream, payload, size))
+        {
+            return false;
+        }
+        event.addArgument(static_cast<std::size_t>(identifier), payload, nullptr, size, alignment);
+    }
+
+    this->entityManager.sendEntityEvent(std::move(event));
+    return true;
+}
+
+bool
+nox::ecs::TraceReplayer::read(std::istream& stream, void* data, std::size_t size)
+{
+    stream.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+    return static_cast<std::size_t>(stream.gcount()) == size;
+}
+
+bool
+nox::ecs::TraceReplayer::readString(std::istream& stream, std::string& value)
+{
+    std::uint32_t size = 0;
+    if (!this->read(stream, &size, sizeof(size)))
+    {
+        return false;
+    }
+
+    value.resize(size);
+    return size == 0 || this->read(stream, &value[0], size);
+}
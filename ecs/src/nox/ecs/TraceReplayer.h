@@ -0,0 +1,110 @@
+#ifndef NOX_ECS_TRACEREPLAYER_H_
+#define NOX_ECS_TRACEREPLAYER_H_
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <unordered_map>
+
+#include <nox/ecs/EntityId.h>
+
+namespace nox
+{
+    namespace ecs
+    {
+        class EntityManager;
+
+        /**
+         * @brief      Plays a trace written by a TraceRecorder back into an
+         *             EntityManager, issuing the same requests in the same
+         *             order. The EntityManager must have the same components
+         *             registered and configured as the recorded one.
+         *
+         *             Entity ids are translated from the recorded ids to the
+         *             ids given by the replayed createEntity calls, so the
+         *             trace can be replayed into a manager that already holds
+         *             entities. Ids that were not created through a recorded
+         *             request, like the children created by the factory, are
+         *             used as is.
+         */
+        class TraceReplayer
+        {
+        public:
+            /**
+             * @brief      Creates a replayer for the given EntityManager.
+             *
+             * @param      entityManager  The manager to replay the traces
+             *                            into, must outlive the replayer.
+             */
+            explicit TraceReplayer(EntityManager& entityManager);
+
+            /**
+             * @brief      Replays the trace until the end of the stream.
+             *
+             * @param      stream  The stream to read the trace from, must be
+             *                     opened in binary mode.
+             *
+             * @return     true if the whole trace was replayed, false if the
+             *             header did not match, or the trace was truncated or
+             *             malformed. Records before the failure have been
+             *             replayed.
+             */
+            bool
+            replay(std::istream& stream);
+
+            /**
+             * @brief      Translates a recorded entity id to the replayed one.
+             *
+             * @param[in]  recordedId  The id in the trace.
+             *
+             * @return     The id of the replayed entity, or recordedId if it
+             *             was not created through a recorded request.
+             */
+            EntityId
+            getReplayedId(const EntityId& recordedId) const;
+
+        private:
+            /**
+             * @brief      Replays the next record in the stream.
+             *
+             * @return     false if the record is malformed.
+             */
+            bool
+            replayRecord(std::istream& stream, std::uint8_t record);
+
+            /**
+             * @brief      Reads and replays a sent entity event.
+             *
+             * @return     false if the event is malformed.
+             */
+            bool
+            replayEvent(std::istream& stream);
+
+            /**
+             * @brief      Reads size raw bytes from the stream.
+             *
+             * @return     false if the stream ended.
+             */
+            bool
+            read(std::istream& stream, void* data, std::size_t size);
+
+            /**
+             * @brief      Reads a string written as its 32 bit length followed
+             *             by its characters.
+             *
+             * @return     false if the stream ended.
+             */
+            bool
+            readString(std::istream& stream, std::string& value);
+
+            EntityManager& entityManager;
+
+            /**
+             * @brief      Maps recorded entity ids to replayed ones.
+             */
+            std::unordered_map<EntityId, EntityId> entityIds{};
+        };
+    }
+}
+
+#endif
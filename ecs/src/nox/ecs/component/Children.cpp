@@ -1,5 +1,6 @@
 #include <nox/ecs/component/Children.h>
 #include <algorithm>
+#include <cstdint>
 
 nox::ecs::Children::Children(Children&& source)
     : nox::ecs::Component(source.id, source.entityManager)
@@ -19,6 +20,29 @@ nox::ecs::Children::operator=(Children&& source)
     return *this;
 }
 
+void
+nox::ecs::Children::writeBinary(std::ostream& stream) const
+{
+    const auto count = static_cast<std::uint32_t>(this->children.size());
+    stream.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    stream.write(reinterpret_cast<const char*>(this->children.data()),
+                 static_cast<std::streamsize>(count * sizeof(EntityId)));
+}
+
+void
+nox::ecs::Children::readBinary(std::istream& stream)
+{
+    std::uint32_t count = 0;
+    stream.read(reinterpret_cast<char*>(&count), sizeof(count));
+
+    // Read one at a time, so a corrupt count fails on the stream rather than on allocation.
+    EntityId childId{};
+    for (std::uint32_t i = 0; i < count && stream.read(reinterpret_cast<char*>(&childId), sizeof(childId)); ++i)
+    {
+        this->children.push_back(childId);
+    }
+}
+
 void
 nox::ecs::Children::addChild(const EntityId& childId)
 {
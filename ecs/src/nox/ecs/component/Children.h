@@ -1,5 +1,7 @@
 #ifndef NOX_ECS_CHILDREN_H_
 #define NOX_ECS_CHILDREN_H_
+#include <istream>
+#include <ostream>
 #include <vector>
 #include <nox/ecs/Component.h>
 
@@ -33,6 +35,22 @@ namespace nox
              */
             Children& operator=(Children&& source);
 
+            /**
+             * @brief      Writes the ids of the children to stream, for
+             *             snapshots.
+             *
+             * @param      stream  The stream to write to.
+             */
+            void writeBinary(std::ostream& stream) const;
+
+            /**
+             * @brief      Reads the ids of the children written by
+             *             writeBinary.
+             *
+             * @param      stream  The stream to read from.
+             */
+            void readBinary(std::istream& stream);
+
             /**
              * @brief      Adds a child to the children component.
              *             Duplicates are not added.
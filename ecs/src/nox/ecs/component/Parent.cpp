@@ -17,3 +17,15 @@ nox::ecs::Parent::operator=(Parent&& source)
     }
     return *this;
 }
+
+void
+nox::ecs::Parent::writeBinary(std::ostream& stream) const
+{
+    stream.write(reinterpret_cast<const char*>(&this->parentId), sizeof(this->parentId));
+}
+
+void
+nox::ecs::Parent::readBinary(std::istream& stream)
+{
+    stream.read(reinterpret_cast<char*>(&this->parentId), sizeof(this->parentId));
+}
@@ -1,5 +1,8 @@
 #ifndef NOX_ECS_PARENT_H_
 #define NOX_ECS_PARENT_H_
+#include <istream>
+#include <ostream>
+
 #include <nox/ecs/Component.h>
 
 namespace nox
@@ -33,6 +36,20 @@ namespace nox
              */
             Parent& operator=(Parent&& other);
 
+            /**
+             * @brief      Writes the parent id to stream, for snapshots.
+             *
+             * @param      stream  The stream to write to.
+             */
+            void writeBinary(std::ostream& stream) const;
+
+            /**
+             * @brief      Reads the parent id written by writeBinary.
+             *
+             * @param      stream  The stream to read from.
+             */
+            void readBinary(std::istream& stream);
+
             /**
              * @brief      Id of the parent to the entity owning this component.
              * 
@@ -8,7 +8,7 @@
 #include <nox/logic/graphics/event/SceneNodeEdited.h>
 #include <nox/logic/IContext.h>
 #include <nox/util/json_utils.h>
-#include <nox/ecs/EventType.h>
+#include <nox/ecs/EventPayload.h>
 
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -92,15 +92,13 @@ nox::ecs::Sprite::receiveEntityEvent(const ecs::Event& event)
 {
     if (event.getType() == event_type::TRANSFORM_CHANGE)
     {
-        const auto position = *static_cast<const glm::vec2*>(event.getArgument(event_arg_type::TRANSFORM_CHANGE_POSITION).value());
-        const auto scale = *static_cast<const glm::vec2*>(event.getArgument(event_arg_type::TRANSFORM_CHANGE_SCALE).value());
-        const auto rotation = *static_cast<const float*>(event.getArgument(event_arg_type::TRANSFORM_CHANGE_ROTATION).value());
+        const auto& change = event.getPayload<event_payload::TransformChange>();
     
         glm::mat4 transformMatrix;
         transformMatrix = glm::translate(transformMatrix, glm::vec3(this->offset, 0.0f));
-        transformMatrix = glm::translate(transformMatrix, glm::vec3(position, 0.0f));
-        transformMatrix = glm::rotate(transformMatrix, rotation, glm::vec3(0.0f, 0.0f, 1.0f));
-        transformMatrix = glm::scale(transformMatrix, glm::vec3(scale, 1.0f));
+        transformMatrix = glm::translate(transformMatrix, glm::vec3(change.position, 0.0f));
+        transformMatrix = glm::rotate(transformMatrix, change.rotation, glm::vec3(0.0f, 0.0f, 1.0f));
+        transformMatrix = glm::scale(transformMatrix, glm::vec3(change.scale, 1.0f));
     
         this->entityTransformNode->setTransform(transformMatrix);
     }
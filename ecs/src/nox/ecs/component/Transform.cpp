@@ -1,11 +1,11 @@
 #include <nox/ecs/component/Transform.h>
 
-#include <nox/ecs/createEventArgument.h>
+#include <nox/ecs/ComponentType.h>
 #include <nox/ecs/EntityManager.h>
 #include <nox/ecs/Event.h>
 #include <nox/ecs/TypeIdentifier.h>
 #include <nox/util/json_utils.h>
-#include <nox/ecs/EventType.h>
+#include <nox/ecs/EventPayload.h>
 
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -47,6 +47,7 @@ nox::ecs::Transform::setPosition(const glm::vec2& position,
                                  bool broadcast)
 {
     this->position = position;
+    this->markChanged();
 
     if (broadcast == true)
     {
@@ -59,6 +60,7 @@ nox::ecs::Transform::setScale(const glm::vec2& scale,
                               bool broadcast)
 {
     this->scale = scale;
+    this->markChanged();
 
     if (broadcast == true)
     {
@@ -71,6 +73,7 @@ nox::ecs::Transform::setRotation(const float rotation,
                                  bool broadcast)
 {
     this->rotation = rotation;
+    this->markChanged();
 
     if (broadcast == true)
     {
@@ -87,6 +90,7 @@ nox::ecs::Transform::setTransform(const glm::vec2& position,
     this->position = position;
     this->scale = scale;
     this->rotation = rotation;
+    this->markChanged();
 
     if (broadcast == true)
     {
@@ -97,13 +101,18 @@ nox::ecs::Transform::setTransform(const glm::vec2& position,
 void 
 nox::ecs::Transform::broadcastTransformChange()
 {
-    auto event = std::move(this->entityManager->createEntityEvent(event_type::TRANSFORM_CHANGE,
-                                                                  this->id,
-                                                                  this->id));
-
-    createEventArgument(event, this->position, event_arg_type::TRANSFORM_CHANGE_POSITION);
-    createEventArgument(event, this->rotation, event_arg_type::TRANSFORM_CHANGE_ROTATION);
-    createEventArgument(event, this->scale, event_arg_type::TRANSFORM_CHANGE_SCALE);
+    event_payload::TransformChange change{};
+    change.position = this->position;
+    change.scale = this->scale;
+    change.rotation = this->rotation;
+
+    this->entityManager->sendEntityEvent(this->entityManager->createEntityEvent(change,
+                                                                                this->id,
+                                                                                this->id));
+}
 
-    this->entityManager->sendEntityEvent(std::move(event));
+void
+nox::ecs::Transform::markChanged()
+{
+    this->entityManager->markComponentChanged(this, TypeIdentifier(component_type::TRANSFORM));
 }
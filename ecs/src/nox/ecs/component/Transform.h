@@ -20,6 +20,12 @@ namespace nox
         public:
             using nox::ecs::Component::Component;
 
+            /**
+             * @brief      initialize only reads the json value, so transforms
+             *             are copied from a prototype.
+             */
+            static constexpr bool cloneable = true;
+
             /*
              * @brief      Initialize class member variables using a json object
              *
@@ -117,6 +123,12 @@ namespace nox
              *             components, and globally to the EventManager.
              */
             void broadcastTransformChange();
+
+            /**
+             * @brief      Marks the transform as changed in the entity
+             *             manager, see EntityManager::forEachChangedComponent.
+             */
+            void markChanged();
         
             glm::vec2 position{};
             glm::vec2 scale{};
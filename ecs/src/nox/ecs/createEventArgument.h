@@ -14,8 +14,9 @@ namespace nox
          * @param[in]  argument    The argument value to put into the event.
          * @param[in]  identifier  The name of the argument.
          *
-         * @tparam     T           c style arrays are illegal. 
-         *                         sizeof(T) + sizeof(Event::Argument) <=
+         * @tparam     T           c style arrays are illegal. The payload is
+         *                         aligned to alignof(T).
+         *                         sizeof(T) + alignment padding <=
          *                         Event::ArgumentAllocator::MAX_SIZE
          */
         template<class T>
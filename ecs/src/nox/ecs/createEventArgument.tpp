@@ -4,19 +4,26 @@ nox::ecs::createEventArgument(Event& event,
                               const T& argument,
                               const TypeIdentifier& identifier)
 {
-    static_assert(sizeof(T) + sizeof(Event::Argument) <= Event::ArgumentAllocator::MAX_SIZE,
-                   "sizeof T + sizeof Event::Argument is larger than Event::ArgumentAllocator::MAX_SIZE");
-    auto memory = static_cast<nox::memory::Byte*>(event.getAllocator().allocate(sizeof(T) + sizeof(Event::Argument)));
+    static_assert(sizeof(T) + Event::ArgumentAllocator::getWorstCasePadding(alignof(T)) <= Event::ArgumentAllocator::MAX_SIZE,
+                   "sizeof T + padding is larger than Event::ArgumentAllocator::MAX_SIZE");
+    auto payload = static_cast<nox::memory::Byte*>(event.getAllocator().allocate(sizeof(T), alignof(T)));
+    new(payload)T(argument);
 
-    auto payloadStart = memory + sizeof(Event::Argument);
-    new(payloadStart)T(argument);
-
-    auto destructor = [](nox::memory::Byte* payload)
+    // Trivially destructible payloads are skipped entirely when the event is destroyed.
+    Event::Argument::Destructor destructor = nullptr;
+    if (!std::is_trivially_destructible<T>::value)
     {
-        reinterpret_cast<T*>(payload)->~T();
-    };
-
-    auto arg = new(memory) Event::Argument(identifier, payloadStart, destructor);
+        destructor = [](nox::memory::Byte* payload)
+        {
+            reinterpret_cast<T*>(payload)->~T();
+        };
+    }
 
-    event.addArgument(arg);
+    // Trivially copyable payloads record their layout, so they can be copied bytewise, e.g. by TraceRecorder.
+    constexpr bool isCopyable = std::is_trivially_copyable<T>::value;
+    event.addArgument(identifier,
+                      payload,
+                      destructor,
+                      isCopyable ? sizeof(T) : 0,
+                      isCopyable ? alignof(T) : 0);
 }
@@ -1,3 +1,6 @@
+#include <cstring>
+#include <istream>
+#include <ostream>
 #include <type_traits>
 #include <nox/ecs/Component.h>
 
@@ -88,6 +91,69 @@ namespace nox
             {
                 return operation;
             }
+
+            /**
+             * @brief      Clone operation for trivially copyable components,
+             *             which are cloned with a memcpy.
+             *
+             * @tparam     T     The component type.
+             *
+             * @return     The clone operation.
+             */
+            template<class T>
+            typename std::enable_if<std::is_trivially_copyable<T>::value, operation::CloneOp>::type
+            getCloneOperation()
+            {
+                return [](Component* component,
+                          const Component* prototype,
+                          const EntityId& id,
+                          EntityManager* manager)
+                {
+                    std::memcpy(static_cast<void*>(component), static_cast<const void*>(prototype), sizeof(T));
+                    component->id = id;
+                    component->entityManager = manager;
+                };
+            }
+
+            /**
+             * @brief      Clone operation for components that have a copy
+             *             constructor of their own.
+             *
+             * @tparam     T     The component type.
+             *
+             * @return     The clone operation.
+             */
+            template<class T>
+            typename std::enable_if<!std::is_trivially_copyable<T>::value &&
+                                    std::is_copy_constructible<T>::value, operation::CloneOp>::type
+            getCloneOperation()
+            {
+                return [](Component* component,
+                          const Component* prototype,
+                          const EntityId& id,
+                          EntityManager* manager)
+                {
+                    new(component)T(*static_cast<const T*>(prototype));
+                    component->id = id;
+                    component->entityManager = manager;
+                };
+            }
+
+            /**
+             * @brief      Components that cannot be copied are not cloned, and
+             *             are initialized per entity instead.
+             *
+             * @tparam     T     The component type.
+             *
+             * @return     nullptr.
+             */
+            template<class T>
+            typename std::enable_if<!std::is_trivially_copyable<T>::value &&
+                                    !std::is_copy_constructible<T>::value, operation::CloneOp>::type
+            getCloneOperation()
+            {
+                return nullptr;
+            }
         }
     }
 }
@@ -121,6 +187,38 @@ nox::ecs::createMetaInformation(const TypeIdentifier& typeIdentifier,
         static_cast<T*>(component)->~T();
     };
 
+    static_assert(!T::cloneable || std::is_copy_constructible<T>::value || std::is_trivially_copyable<T>::value,
+                  "Type T must be copyable to be cloneable");
+
+    // Cloning skips initialize, so types must opt in. Prototypes only pay off if there is an initialize to skip.
+    info.clone = (T::cloneable) ? meta::getOperation(&Component::initialize,
+                                                     &T::initialize,
+                                                     info.clone,
+                                                     meta::getCloneOperation<T>())
+                                : nullptr;
+
+    info.triviallyCopyable = std::is_trivially_copyable<T>::value;
+
+    info.serialize =
+        meta::getOperation(&Component::writeBinary,
+                           &T::writeBinary,
+                           info.serialize,
+                           [](const Component* component,
+                              std::ostream& stream)
+                           {
+                               static_cast<const T*>(component)->writeBinary(stream);
+                           });
+
+    info.deserialize =
+        meta::getOperation(&Component::readBinary,
+                           &T::readBinary,
+                           info.deserialize,
+                           [](Component* component,
+                              std::istream& stream)
+                           {
+                               static_cast<T*>(component)->readBinary(stream);
+                           });
+
     info.initialize =
         meta::getOperation(&Component::initialize,
                            &T::initialize,
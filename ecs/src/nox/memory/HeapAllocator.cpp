@@ -1,17 +1,52 @@
 #include <nox/memory/HeapAllocator.h>
+#include <algorithm>
 #include <cstdlib>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
 
+#include <nox/memory/alignment.h>
 #include <nox/util/nox_assert.h>
 
 void*
 nox::memory::HeapAllocator::allocate(std::size_t size)
 {
     NOX_ASSERT(size > 0, "Trying to allocate %zu bytes, %zu is not > 0", size, size);
-    return std::malloc(size);
+    #ifdef _WIN32
+        // Memory from _aligned_malloc must be given to _aligned_free, so all allocations go through it.
+        return _aligned_malloc(size, alignof(std::max_align_t));
+    #else
+        return std::malloc(size);
+    #endif
+}
+
+void*
+nox::memory::HeapAllocator::allocate(std::size_t size, std::size_t alignment)
+{
+    NOX_ASSERT(size > 0, "Trying to allocate %zu bytes, %zu is not > 0", size, size);
+    NOX_ASSERT(isValidAlignment(alignment), "Alignment %zu is not a power of two", alignment);
+
+    // posix_memalign requires a multiple of sizeof(void*), and malloc already gives max_align_t.
+    alignment = std::max(alignment, alignof(std::max_align_t));
+
+    #ifdef _WIN32
+        return _aligned_malloc(size, alignment);
+    #else
+        void* ptr = nullptr;
+        if (posix_memalign(&ptr, alignment, size) != 0)
+        {
+            return nullptr;
+        }
+        return ptr;
+    #endif
 }
 
 void
 nox::memory::HeapAllocator::deallocate(void* ptr)
 {
-    std::free(ptr);
+    #ifdef _WIN32
+        _aligned_free(ptr);
+    #else
+        std::free(ptr);
+    #endif
 }
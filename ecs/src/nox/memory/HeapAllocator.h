@@ -28,10 +28,24 @@ namespace nox
              */
             void* allocate(std::size_t size);
 
+            /**
+             * @brief      Allocates size amount of uninitialized memory, aligned
+             *             to alignment.
+             *
+             * @param[in]  size       The size to allocate in bytes.
+             *                        size must be > 0.
+             * @param[in]  alignment  The alignment of the memory, must be a
+             *                        power of two.
+             *
+             * @return     ptr to newly allocated memory.
+             */
+            void* allocate(std::size_t size, std::size_t alignment);
+
             /**
              * @brief      Deallocates the memory pointed to by ptr. Ptr must be
              *             pointing to an object previously allocated through
-             *             this allocator.
+             *             this allocator, through either of the allocate
+             *             functions.
              *
              * @param      ptr   Ptr to memory to deallocate.
              */
@@ -12,6 +12,11 @@ namespace nox
          *             slotCount number of slots of slotSize size. Memory is
          *             freed upon destruction.
          *
+         *             Like LockFreeAllocator, clear only resets the blocks
+         *             used since the previous clear, zeroes nothing unless
+         *             NOX_MEMORY_ZERO_ON_CLEAR is defined, and frees surplus
+         *             blocks after setReleaseThreshold quiet clears.
+         *
          * @tparam     blockSize  How big each allocated block is.
          */
         template<std::size_t blockSize>
@@ -21,6 +26,12 @@ namespace nox
             
             static constexpr std::size_t MAX_SIZE = blockSize;
 
+            /**
+             * @brief      Default number of quiet clears before surplus
+             *             blocks are freed, i.e. about a second of frames.
+             */
+            static constexpr std::size_t DEFAULT_RELEASE_THRESHOLD = 60;
+
             /**
              * @brief      Creates the LinearAllocator with as many blocks as
              *             specified by the parameter.
@@ -79,6 +90,31 @@ namespace nox
              * @return     Pointer to allocated uninitialized memory.
              */
             void* allocate(std::size_t size);
+
+            /**
+             * @brief      Allocates size bytes of uninitialized storage aligned
+             *             to alignment.
+             *
+             * @param[in]  size       The size of the memory to allocate, in
+             *                        bytes. size must satisfy: 0 < size and
+             *                        size + getWorstCasePadding(alignment) <=
+             *                        MAX_SIZE.
+             * @param[in]  alignment  The alignment of the memory, must be a
+             *                        power of two.
+             *
+             * @return     Pointer to allocated uninitialized memory.
+             */
+            void* allocate(std::size_t size, std::size_t alignment);
+
+            /**
+             * @brief      Returns the most padding an allocation with the
+             *             given alignment can need in an empty block.
+             *
+             * @param[in]  alignment  The alignment, must be a power of two.
+             *
+             * @return     The padding in bytes.
+             */
+            static constexpr std::size_t getWorstCasePadding(std::size_t alignment);
             
             /**
              * @brief      Function is ignored in this allocator. The function
@@ -91,12 +127,31 @@ namespace nox
             void deallocate(void* /*ptr*/) {}
 
             /**
-             * @brief      Resets all the slots to 0. User must ensure that
-             *             delete has been called on all stored elements first.
-             *             Memory is not freed until destruction.
+             * @brief      Prepares all the slots for reuse. User must ensure
+             *             that delete has been called on all stored elements
+             *             first. Surplus blocks might be freed, see
+             *             setReleaseThreshold.
              */ 
             void clear();
 
+            /**
+             * @brief      Sets how many clears in a row must use fewer blocks
+             *             than the allocator holds, before the surplus blocks
+             *             are freed. The allocator never goes below its
+             *             initial block count.
+             *
+             * @param[in]  clearCount  The number of clears, 0 disables
+             *                         freeing blocks before destruction.
+             */
+            void setReleaseThreshold(std::size_t clearCount);
+
+            /**
+             * @brief      Returns the number of blocks held by the allocator.
+             *
+             * @return     The number of blocks held.
+             */
+            std::size_t getBlockCount() const;
+
         private:
             /**
              * @brief      Block holding a link to the next block, as well as
@@ -116,10 +171,29 @@ namespace nox
 
                 /**
                  * @brief      Area of raw memory which is allocated into.
+                 *             Left uninitialized, aligned so that allocations
+                 *             up to alignof(std::max_align_t) need no padding
+                 *             in an empty block.
                  */
-                Byte slots[MAX_SIZE]{0};
+                alignas(std::max_align_t) Byte slots[MAX_SIZE];
             };
 
+            /**
+             * @brief      Moves firstFree to the next block, creating it if
+             *             needed.
+             */
+            void advanceBlock();
+
+            /**
+             * @brief      Frees the blocks beyond the first keepCount blocks.
+             */
+            void release(std::size_t keepCount);
+
+            /**
+             * @brief      Frees all the blocks.
+             */
+            void destroyBlocks();
+
             /**
              * @brief Pointer to the first block within the list.
              */
@@ -129,6 +203,32 @@ namespace nox
              * @brief Pointer to the first block that contains free slots.
              */
             Block* firstFree{};
+
+            /**
+             * @brief Number of blocks in the list.
+             */
+            std::size_t blockCount{0};
+
+            /**
+             * @brief The allocator never frees blocks below this count.
+             */
+            std::size_t minimumBlockCount{1};
+
+            /**
+             * @brief See setReleaseThreshold.
+             */
+            std::size_t releaseThreshold{DEFAULT_RELEASE_THRESHOLD};
+
+            /**
+             * @brief Number of clears in a row that have used fewer blocks
+             *        than held.
+             */
+            std::size_t quietClearCount{0};
+
+            /**
+             * @brief Most blocks used by any of the quiet clears.
+             */
+            std::size_t quietPeakBlockCount{0};
         };
     }
 }
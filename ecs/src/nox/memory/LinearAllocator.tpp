@@ -1,29 +1,40 @@
+#include <nox/memory/alignment.h>
 #include <nox/util/nox_assert.h>
+#include <algorithm>
 #include <cstring>
 
 template<std::size_t blockSize>
 nox::memory::LinearAllocator<blockSize>::LinearAllocator(std::size_t initialBlockCount) 
 {
     NOX_ASSERT(initialBlockCount > 0, "At least one block must be allocated!");
-    this->first = new Block();
+    this->first = new Block;
     this->firstFree = this->first;
 
     // Doing -1 because we have already done the first block.
     auto itr = this->first;
     for (std::size_t i = 0; i < initialBlockCount - 1; ++i)
     {
-        itr->next = new Block();
+        itr->next = new Block;
         itr = itr->next;
     }
+
+    this->blockCount = initialBlockCount;
+    this->minimumBlockCount = initialBlockCount;
 }
 
 template<std::size_t blockSize>
 nox::memory::LinearAllocator<blockSize>::LinearAllocator(LinearAllocator&& source)
     : first(source.first)
     , firstFree(source.firstFree)
+    , blockCount(source.blockCount)
+    , minimumBlockCount(source.minimumBlockCount)
+    , releaseThreshold(source.releaseThreshold)
+    , quietClearCount(source.quietClearCount)
+    , quietPeakBlockCount(source.quietPeakBlockCount)
 {
     source.first = nullptr;
     source.firstFree = nullptr;
+    source.blockCount = 0;
 }
 
 template<std::size_t blockSize>
@@ -33,18 +44,19 @@ nox::memory::LinearAllocator<blockSize>::operator=(LinearAllocator&& source)
     if (this != &source)
     {
         // Ensure that we don't leak.
-        while (this->first != nullptr)
-        {
-            auto tmp = this->first->next;
-            delete this->first;
-            this->first = tmp;   
-        }
+        this->destroyBlocks();
 
         this->first = source.first;
         this->firstFree = source.firstFree;
+        this->blockCount = source.blockCount;
+        this->minimumBlockCount = source.minimumBlockCount;
+        this->releaseThreshold = source.releaseThreshold;
+        this->quietClearCount = source.quietClearCount;
+        this->quietPeakBlockCount = source.quietPeakBlockCount;
 
         source.first = nullptr;
         source.firstFree = nullptr;
+        source.blockCount = 0;
     }
     return *this;
 }
@@ -52,12 +64,7 @@ nox::memory::LinearAllocator<blockSize>::operator=(LinearAllocator&& source)
 template<std::size_t blockSize>
 nox::memory::LinearAllocator<blockSize>::~LinearAllocator()
 {
-    while (this->first != nullptr)
-    {
-        auto tmp = this->first->next;
-        delete this->first;
-        this->first = tmp;   
-    }
+    this->destroyBlocks();
 }
 
 template<std::size_t blockSize>
@@ -67,27 +74,145 @@ nox::memory::LinearAllocator<blockSize>::allocate(std::size_t size)
     NOX_ASSERT(size <= blockSize, "Requesting to large allocation! MAX_SIZE: %zu, Argument: %zu", blockSize, size);
     if (this->firstFree->used + size >= MAX_SIZE)
     {
-        // Might be that we are reusing a block here, which can happen after we have done a reset.
-        auto newBlock = (this->firstFree->next != nullptr) ? this->firstFree->next : new Block();
-        this->firstFree->next = newBlock;
-        this->firstFree = newBlock;
+        this->advanceBlock();
     }
     auto ret = &(this->firstFree->slots[this->firstFree->used]);
     this->firstFree->used += size;
     return ret;
 }
 
+template<std::size_t blockSize>
+void*
+nox::memory::LinearAllocator<blockSize>::allocate(std::size_t size, std::size_t alignment)
+{
+    NOX_ASSERT(isValidAlignment(alignment), "Alignment %zu is not a power of two", alignment);
+    NOX_ASSERT(size > 0 && size + getWorstCasePadding(alignment) <= MAX_SIZE,
+               "Requesting to large allocation! MAX_SIZE: %zu, Argument: %zu, Alignment: %zu",
+               blockSize, size, alignment);
+
+    auto start = this->firstFree->used + getAlignmentPadding(&this->firstFree->slots[this->firstFree->used], alignment);
+    if (start + size > MAX_SIZE)
+    {
+        this->advanceBlock();
+        start = this->firstFree->used + getAlignmentPadding(&this->firstFree->slots[this->firstFree->used], alignment);
+    }
+    auto ret = &(this->firstFree->slots[start]);
+    this->firstFree->used = start + size;
+    return ret;
+}
+
+template<std::size_t blockSize>
+constexpr std::size_t
+nox::memory::LinearAllocator<blockSize>::getWorstCasePadding(std::size_t alignment)
+{
+    return (alignment > alignof(std::max_align_t)) ? alignment - alignof(std::max_align_t) : 0;
+}
+
 template<std::size_t blockSize>
 void 
 nox::memory::LinearAllocator<blockSize>::clear()
 {
+    // Blocks after firstFree have not been touched since the last clear.
+    std::size_t usedBlockCount = 0;
+
     auto itr = this->first;
     while (itr)
     {
+        ++usedBlockCount;
+        #ifdef NOX_MEMORY_ZERO_ON_CLEAR
+            std::memset(itr->slots, 0, itr->used);
+        #endif
         itr->used = 0;
-        std::memset(itr->slots, 0, MAX_SIZE);
+
+        if (itr == this->firstFree)
+        {
+            break;
+        }
         itr = itr->next;
     }
 
     this->firstFree = this->first;
+
+    if (this->releaseThreshold == 0)
+    {
+        return;
+    }
+
+    if (usedBlockCount >= this->blockCount)
+    {
+        this->quietClearCount = 0;
+        this->quietPeakBlockCount = 0;
+        return;
+    }
+
+    this->quietPeakBlockCount = std::max(this->quietPeakBlockCount, usedBlockCount);
+    if (++this->quietClearCount >= this->releaseThreshold)
+    {
+        this->release(std::max(this->quietPeakBlockCount, this->minimumBlockCount));
+        this->quietClearCount = 0;
+        this->quietPeakBlockCount = 0;
+    }
+}
+
+template<std::size_t blockSize>
+void
+nox::memory::LinearAllocator<blockSize>::setReleaseThreshold(std::size_t clearCount)
+{
+    this->releaseThreshold = clearCount;
+}
+
+template<std::size_t blockSize>
+std::size_t
+nox::memory::LinearAllocator<blockSize>::getBlockCount() const
+{
+    return this->blockCount;
+}
+
+template<std::size_t blockSize>
+void
+nox::memory::LinearAllocator<blockSize>::advanceBlock()
+{
+    // Might be that we are reusing a block here, which can happen after we have done a reset.
+    auto newBlock = this->firstFree->next;
+    if (newBlock == nullptr)
+    {
+        newBlock = new Block;
+        ++this->blockCount;
+    }
+    this->firstFree->next = newBlock;
+    this->firstFree = newBlock;
+}
+
+template<std::size_t blockSize>
+void
+nox::memory::LinearAllocator<blockSize>::release(std::size_t keepCount)
+{
+    auto last = this->first;
+    for (std::size_t i = 1; i < keepCount && last->next; ++i)
+    {
+        last = last->next;
+    }
+
+    auto itr = last->next;
+    last->next = nullptr;
+    while (itr)
+    {
+        auto next = itr->next;
+        delete itr;
+        itr = next;
+    }
+
+    this->blockCount = keepCount;
+}
+
+template<std::size_t blockSize>
+void
+nox::memory::LinearAllocator<blockSize>::destroyBlocks()
+{
+    while (this->first != nullptr)
+    {
+        auto tmp = this->first->next;
+        delete this->first;
+        this->first = tmp;   
+    }
 }
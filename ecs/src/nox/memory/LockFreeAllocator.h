@@ -19,9 +19,13 @@ namespace nox
          *             can suffer from internal fragmentation, and should only
          *             be used for short lived allocations.
          *
-         * @note       Currently the allocator does not support functionality
-         *             for deallocating these pools, this should be added in the
-         *             future.
+         *             clear only resets the blocks used since the previous
+         *             clear, and does not zero the memory unless
+         *             NOX_MEMORY_ZERO_ON_CLEAR is defined. If the allocator
+         *             has used fewer blocks than it holds for a number of
+         *             clears in a row (see setReleaseThreshold), the blocks
+         *             beyond the most used in that period are freed, so a
+         *             single burst does not keep its memory forever.
          *
          * @tparam     blockSize  The size of each memory block within each
          *                        element of the list. i.e. How much memory to
@@ -36,6 +40,12 @@ namespace nox
              */
             static constexpr std::size_t MAX_SIZE = blockSize;
 
+            /**
+             * @brief      Default number of quiet clears before surplus
+             *             blocks are freed, i.e. about a second of frames.
+             */
+            static constexpr std::size_t DEFAULT_RELEASE_THRESHOLD = 60;
+
             /**
              * @brief      Creates the LockFreeAllocator with as many blocks as
              *             specified by the parameter.
@@ -81,6 +91,33 @@ namespace nox
              * @return     Pointer to allocated uninitialized memory.
              */
             void* allocate(std::size_t size);
+
+            /**
+             * @brief      Allocates size bytes of uninitialized storage aligned
+             *             to alignment. The padding is claimed together with
+             *             the storage, so the function stays lock-free and can
+             *             be called concurrently.
+             *
+             * @param[in]  size       The size of the memory to allocate, in
+             *                        bytes. size must satisfy: 0 < size and
+             *                        size + getWorstCasePadding(alignment) <=
+             *                        MAX_SIZE.
+             * @param[in]  alignment  The alignment of the memory, must be a
+             *                        power of two.
+             *
+             * @return     Pointer to allocated uninitialized memory.
+             */
+            void* allocate(std::size_t size, std::size_t alignment);
+
+            /**
+             * @brief      Returns the most padding an allocation with the
+             *             given alignment can need in an empty block.
+             *
+             * @param[in]  alignment  The alignment, must be a power of two.
+             *
+             * @return     The padding in bytes.
+             */
+            static constexpr std::size_t getWorstCasePadding(std::size_t alignment);
             
             /**
              * @brief      Function is ignored in this allocator. The function
@@ -95,14 +132,32 @@ namespace nox
             /**
              * @brief      Prepares all elements for reuse. User must ensure
              *             that the destructor has been run on all stored
-             *             elements first. Memory is not freed until
-             *             destruction.
+             *             elements first. Surplus blocks might be freed, see
+             *             setReleaseThreshold.
              *
              *             Function cannot be called concurrently. As it could
              *             result in memory corruption.
              */ 
             void clear();
 
+            /**
+             * @brief      Sets how many clears in a row must use fewer blocks
+             *             than the allocator holds, before the surplus blocks
+             *             are freed. The allocator never goes below its
+             *             initial block count.
+             *
+             * @param[in]  clearCount  The number of clears, 0 disables
+             *                         freeing blocks before destruction.
+             */
+            void setReleaseThreshold(std::size_t clearCount);
+
+            /**
+             * @brief      Returns the number of blocks held by the allocator.
+             *
+             * @return     The number of blocks held.
+             */
+            std::size_t getBlockCount() const;
+
         private:
             /**
              * @brief      Block holding a link to the next block, as well as
@@ -122,21 +177,30 @@ namespace nox
 
                 /**
                  * @brief      Area of raw memory which is allocated into.
+                 *             Left uninitialized, aligned so that allocations
+                 *             up to alignof(std::max_align_t) need no padding
+                 *             in an empty block.
                  */
-                Byte memory[MAX_SIZE]{0};
+                alignas(std::max_align_t) Byte memory[MAX_SIZE];
             };
 
+            /**
+             * @brief      Frees the blocks beyond the first keepCount blocks.
+             */
+            void release(std::size_t keepCount);
+
             /**
              * @brief      Tries to allocate size bytes of uninitialized storage
              *             within the memory of the block.
              *
-             * @param      block  The block to try and allocate into.
-             * @param      size   The size in bytes to allocate.
+             * @param      block      The block to try and allocate into.
+             * @param      size       The size in bytes to allocate.
+             * @param      alignment  The alignment of the storage.
              *
              * @return     Pointer to uninitialized storage within the memory of
              *             block if success, nullptr if the allocation fails.
              */
-            void* tryAllocate(Block& block, std::size_t size);
+            void* tryAllocate(Block& block, std::size_t size, std::size_t alignment);
 
             /**
              * @brief      Pointer to the first block within the list.
@@ -148,6 +212,33 @@ namespace nox
              * @brief      Pointer to the first block that contains free slots.
              */
             std::atomic<Block*> firstFree{};
+
+            /**
+             * @brief      Number of blocks in the list. Only incremented while
+             *             allocating, so ordering is relaxed.
+             */
+            std::atomic<std::size_t> blockCount{0};
+
+            /**
+             * @brief      The allocator never frees blocks below this count.
+             */
+            std::size_t minimumBlockCount{1};
+
+            /**
+             * @brief      See setReleaseThreshold.
+             */
+            std::size_t releaseThreshold{DEFAULT_RELEASE_THRESHOLD};
+
+            /**
+             * @brief      Number of clears in a row that have used fewer
+             *             blocks than held.
+             */
+            std::size_t quietClearCount{0};
+
+            /**
+             * @brief      Most blocks used by any of the quiet clears.
+             */
+            std::size_t quietPeakBlockCount{0};
         };
     }
 }
@@ -1,20 +1,25 @@
+#include <nox/memory/alignment.h>
 #include <nox/util/nox_assert.h>
+#include <algorithm>
 #include <cstring>
 
 template<std::size_t blockSize>
 nox::memory::LockFreeAllocator<blockSize>::LockFreeAllocator(std::size_t initialBlockCount) 
 {
     NOX_ASSERT(initialBlockCount > 0, "At least one block must be allocated!");
-    this->first = new Block();
+    this->first = new Block;
     this->firstFree = this->first;
 
     // Doing -1 because we have already done the first block.
     auto itr = this->first;
     for (std::size_t i = 0; i < initialBlockCount - 1; ++i)
     {
-        itr->next = new Block();
+        itr->next = new Block;
         itr = itr->next;
     }
+
+    this->blockCount.store(initialBlockCount, std::memory_order_relaxed);
+    this->minimumBlockCount = initialBlockCount;
 }
 
 template<std::size_t blockSize>
@@ -33,6 +38,18 @@ void*
 nox::memory::LockFreeAllocator<blockSize>::allocate(const std::size_t size)
 {
     NOX_ASSERT(size > 0 && size <= MAX_SIZE, "param size must satisfy 0 < size <= MAX_SIZE, size was: %zu", size);
+    return this->allocate(size, 1);
+}
+
+template<std::size_t blockSize>
+void* 
+nox::memory::LockFreeAllocator<blockSize>::allocate(const std::size_t size,
+                                                    const std::size_t alignment)
+{
+    NOX_ASSERT(isValidAlignment(alignment), "Alignment %zu is not a power of two", alignment);
+    NOX_ASSERT(size > 0 && size + getWorstCasePadding(alignment) <= MAX_SIZE,
+               "param size must satisfy 0 < size <= MAX_SIZE - padding, size was: %zu, alignment was: %zu",
+               size, alignment);
 
     Block* desired = nullptr;
     bool allocated = false;
@@ -44,7 +61,7 @@ nox::memory::LockFreeAllocator<blockSize>::allocate(const std::size_t size)
         // Ensure that each time we come around we have as new version of firstFree as possible.
         Block* expected = this->firstFree.load(std::memory_order_acquire);
         
-        memory = this->tryAllocate(*expected, size);
+        memory = this->tryAllocate(*expected, size, alignment);
         if (memory)
         {
             if (allocated)
@@ -59,7 +76,7 @@ nox::memory::LockFreeAllocator<blockSize>::allocate(const std::size_t size)
             desired = expected->next;
             if (desired == nullptr)
             {
-                desired = new Block();
+                desired = new Block;
                 allocated = true;
             }
         }
@@ -78,8 +95,12 @@ nox::memory::LockFreeAllocator<blockSize>::allocate(const std::size_t size)
             // We know that everyone watching the firstFree variable will now see "desired",
             // meaning it should not be a data race to update prev->next.
             prev->next = desired;
+            if (allocated)
+            {
+                this->blockCount.fetch_add(1, std::memory_order_relaxed);
+            }
             
-            memory = this->tryAllocate(*desired, size);
+            memory = this->tryAllocate(*desired, size, alignment);
 
             // If we have allocated memory, but someone has already used all of it!
             // We will need to do another iteration, but we can't delete desired, 
@@ -95,29 +116,109 @@ template<std::size_t blockSize>
 void 
 nox::memory::LockFreeAllocator<blockSize>::clear()
 {
+    // Blocks after firstFree have not been touched since the last clear.
+    const auto last = this->firstFree.load(std::memory_order_acquire);
+    std::size_t usedBlockCount = 0;
+
     auto itr = this->first;
     while (itr)
     {
+        ++usedBlockCount;
+        #ifdef NOX_MEMORY_ZERO_ON_CLEAR
+            std::memset(itr->memory, 0, itr->used.load(std::memory_order_relaxed));
+        #endif
         itr->used.store(0, std::memory_order_release);
-        std::memset(itr->memory, 0, MAX_SIZE);
+
+        if (itr == last)
+        {
+            break;
+        }
         itr = itr->next;
     }
 
     this->firstFree.store(this->first, std::memory_order_release);
+
+    if (this->releaseThreshold == 0)
+    {
+        return;
+    }
+
+    if (usedBlockCount >= this->blockCount.load(std::memory_order_relaxed))
+    {
+        this->quietClearCount = 0;
+        this->quietPeakBlockCount = 0;
+        return;
+    }
+
+    this->quietPeakBlockCount = std::max(this->quietPeakBlockCount, usedBlockCount);
+    if (++this->quietClearCount >= this->releaseThreshold)
+    {
+        this->release(std::max(this->quietPeakBlockCount, this->minimumBlockCount));
+        this->quietClearCount = 0;
+        this->quietPeakBlockCount = 0;
+    }
+}
+
+template<std::size_t blockSize>
+constexpr std::size_t
+nox::memory::LockFreeAllocator<blockSize>::getWorstCasePadding(const std::size_t alignment)
+{
+    return (alignment > alignof(std::max_align_t)) ? alignment - alignof(std::max_align_t) : 0;
+}
+
+template<std::size_t blockSize>
+void
+nox::memory::LockFreeAllocator<blockSize>::setReleaseThreshold(std::size_t clearCount)
+{
+    this->releaseThreshold = clearCount;
+}
+
+template<std::size_t blockSize>
+std::size_t
+nox::memory::LockFreeAllocator<blockSize>::getBlockCount() const
+{
+    return this->blockCount.load(std::memory_order_relaxed);
+}
+
+template<std::size_t blockSize>
+void
+nox::memory::LockFreeAllocator<blockSize>::release(std::size_t keepCount)
+{
+    auto last = this->first;
+    for (std::size_t i = 1; i < keepCount && last->next; ++i)
+    {
+        last = last->next;
+    }
+
+    auto itr = last->next;
+    last->next = nullptr;
+    while (itr)
+    {
+        auto next = itr->next;
+        delete itr;
+        itr = next;
+    }
+
+    this->blockCount.store(keepCount, std::memory_order_relaxed);
 }
 
 template<std::size_t blockSize>
 void* 
 nox::memory::LockFreeAllocator<blockSize>::tryAllocate(Block& block, 
-                                                       const std::size_t size)
+                                                       const std::size_t size,
+                                                       const std::size_t alignment)
 {
     // Only need to load this value once, as it is updated in the compare_exchange.
     std::size_t current = block.used.load(std::memory_order_acquire);
+    std::size_t start = 0;
     std::size_t desired = 0;
     
     do
     {
-        desired = current + size;
+        // The padding is claimed in the same exchange as the storage, so it is recomputed
+        // from whatever offset we are competing for.
+        start = current + getAlignmentPadding(&block.memory[0] + current, alignment);
+        desired = start + size;
         if (desired > MAX_SIZE)
         {
             return nullptr;
@@ -128,7 +229,7 @@ nox::memory::LockFreeAllocator<blockSize>::tryAllocate(Block& block,
                                                std::memory_order_acq_rel,
                                                std::memory_order_relaxed));
 
-    // At this point we know current < block->used,
+    // At this point we know start < block->used,
     // meaning it should not be a race to send this back.
-    return &block.memory[current];
+    return &block.memory[start];
 }
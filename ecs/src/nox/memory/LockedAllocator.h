@@ -15,7 +15,9 @@ namespace nox
          *             but additionally it locks with a mutex.
          *             LockAllocator is non-movable and non-copyable because of its mutex.
          *
-         * @tparam     Allocator  requires 3 functions.
+         * @tparam     Allocator  requires 3 functions, and
+         *             void* allocate(std::size_t size, std::size_t alignment);
+         *             if the aligned overload is used.
          *             void* allocate(std::size_t size);
          *             void deallocate(void* ptr);
          *             void clear();
@@ -37,6 +39,11 @@ namespace nox
              * @brief      Takes the mutex lock, and forwards to Allocator::allocate.
              */
             void* allocate(std::size_t size);
+
+            /**
+             * @brief      Takes the mutex lock, and forwards to the aligned Allocator::allocate.
+             */
+            void* allocate(std::size_t size, std::size_t alignment);
             
             /**
              * @brief       Takes the mutex lock, and forwards to Allocator::deallocate.
@@ -6,6 +6,14 @@ nox::memory::LockedAllocator<Allocator>::allocate(std::size_t size)
     return allocator.allocate(size);
 }
 
+template<class Allocator>
+void* 
+nox::memory::LockedAllocator<Allocator>::allocate(std::size_t size, std::size_t alignment)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return allocator.allocate(size, alignment);
+}
+
 template<class Allocator>
 void
 nox::memory::LockedAllocator<Allocator>::deallocate(void* ptr)
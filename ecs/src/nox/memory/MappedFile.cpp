@@ -0,0 +1,129 @@
+#include <nox/memory/MappedFile.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+nox::memory::MappedFile::MappedFile(const std::string& path)
+{
+    #ifdef _WIN32
+        const auto file = ::CreateFileA(path.c_str(),
+                                        GENERIC_READ,
+                                        FILE_SHARE_READ,
+                                        nullptr,
+                                        OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL,
+                                        nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (::GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+        {
+            const auto mappingObject = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mappingObject)
+            {
+                const auto mapping = ::MapViewOfFile(mappingObject, FILE_MAP_READ, 0, 0, 0);
+                if (mapping)
+                {
+                    this->mapping = static_cast<const Byte*>(mapping);
+                    this->mappingSize = static_cast<std::size_t>(fileSize.QuadPart);
+                }
+
+                // The view keeps its own reference to the mapping object.
+                ::CloseHandle(mappingObject);
+            }
+        }
+
+        ::CloseHandle(file);
+    #else
+        const auto file = ::open(path.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            return;
+        }
+
+        struct stat status;
+        if (::fstat(file, &status) == 0 && status.st_size > 0)
+        {
+            const auto size = static_cast<std::size_t>(status.st_size);
+            const auto mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+            if (mapping != MAP_FAILED)
+            {
+                this->mapping = static_cast<const Byte*>(mapping);
+                this->mappingSize = size;
+            }
+        }
+
+        // The mapping keeps its own reference to the file.
+        ::close(file);
+    #endif
+}
+
+nox::memory::MappedFile::MappedFile(MappedFile&& source)
+    : mapping(source.mapping)
+    , mappingSize(source.mappingSize)
+{
+    source.mapping = nullptr;
+    source.mappingSize = 0;
+}
+
+nox::memory::MappedFile&
+nox::memory::MappedFile::operator=(MappedFile&& source)
+{
+    if (this != &source)
+    {
+        this->close();
+        this->mapping = source.mapping;
+        this->mappingSize = source.mappingSize;
+        source.mapping = nullptr;
+        source.mappingSize = 0;
+    }
+
+    return *this;
+}
+
+nox::memory::MappedFile::~MappedFile()
+{
+    this->close();
+}
+
+bool
+nox::memory::MappedFile::isOpen() const
+{
+    return this->mapping != nullptr;
+}
+
+const nox::memory::Byte*
+nox::memory::MappedFile::data() const
+{
+    return this->mapping;
+}
+
+std::size_t
+nox::memory::MappedFile::size() const
+{
+    return this->mappingSize;
+}
+
+void
+nox::memory::MappedFile::close()
+{
+    if (this->mapping)
+    {
+        #ifdef _WIN32
+            ::UnmapViewOfFile(this->mapping);
+        #else
+            ::munmap(const_cast<Byte*>(this->mapping), this->mappingSize);
+        #endif
+        this->mapping = nullptr;
+        this->mappingSize = 0;
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef NOX_MEMORY_MAPPEDFILE_H_
+#define NOX_MEMORY_MAPPEDFILE_H_
+#include <cstddef>
+#include <string>
+
+#include <nox/memory/Byte.h>
+
+namespace nox
+{
+    namespace memory
+    {
+        /**
+         * @brief      Read-only memory mapping of a whole file. The pages are
+         *             loaded by the OS as they are touched, so opening even a
+         *             large file is close to free, and the mapping start is
+         *             page aligned.
+         *
+         *             The mapping is released on destruction, any pointer
+         *             into data() is invalid after that. Moving the mapping
+         *             keeps the data in place.
+         *
+         *             Uses mmap on POSIX systems, and MapViewOfFile on
+         *             Windows.
+         */
+        class MappedFile
+        {
+        public:
+            /**
+             * @brief      Creates an empty mapping, see isOpen.
+             */
+            MappedFile() = default;
+
+            /**
+             * @brief      Maps the file at path. Check isOpen to see if the
+             *             mapping succeeded.
+             *
+             * @param[in]  path  The path of the file.
+             */
+            explicit MappedFile(const std::string& path);
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            MappedFile(MappedFile&& source);
+            MappedFile& operator=(MappedFile&& source);
+
+            ~MappedFile();
+
+            /**
+             * @brief      Checks if a file is mapped. Empty files are never
+             *             mapped.
+             *
+             * @return     true if data() points to the file.
+             */
+            bool
+            isOpen() const;
+
+            /**
+             * @brief      Returns the start of the mapping.
+             *
+             * @return     The first byte of the file, nullptr if no file is
+             *             mapped.
+             */
+            const Byte*
+            data() const;
+
+            /**
+             * @brief      Returns the size of the mapping.
+             *
+             * @return     The size of the file in bytes.
+             */
+            std::size_t
+            size() const;
+
+        private:
+            /**
+             * @brief      Unmaps the file, if any.
+             */
+            void
+            close();
+
+            const Byte* mapping{nullptr};
+            std::size_t mappingSize{0};
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,248 @@
+#ifndef NOX_MEMORY_POOLALLOCATOR_H_
+#define NOX_MEMORY_POOLALLOCATOR_H_
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include <nox/memory/Byte.h>
+#include <nox/memory/LockFreeAllocator.h>
+#include <nox/thread/TaggedPointer.h>
+#include <nox/thread/ThreadIndex.h>
+
+namespace nox
+{
+    namespace memory
+    {
+        /**
+         * @brief      Thread safe allocator handing out blocks of a fixed
+         *             size, which unlike the linear allocators can be
+         *             deallocated one by one, and reused in O(1).
+         *
+         * @detail     Every thread (see nox::thread::ThreadIndex) has its own
+         *             cache of free blocks, which allocate and deallocate work
+         *             on without any synchronization. When a cache grows too
+         *             large, a batch of blocks is moved to a global lock-free
+         *             list, where caches running empty refill from. Only if
+         *             the global list is empty are new blocks carved out of a
+         *             LockFreeAllocator. Memory is therefore never given back
+         *             before clear or destruction, but does not grow beyond
+         *             the largest number of blocks in use at once.
+         *
+         *             Threads without an index share a separate lock-free
+         *             list of single blocks.
+         *
+         *             Nothing is allocated until the first allocation, and
+         *             each thread only allocates its cache when it first
+         *             uses the allocator, as every LockFreeStack owns one,
+         *             and most of them are never touched by most threads.
+         *
+         * @tparam     blockSize  The size of each block. Every allocation
+         *                        gets a block of this size, aligned for any
+         *                        fundamental type.
+         */
+        template<std::size_t blockSize>
+        class PoolAllocator
+        {
+        public:
+            /**
+             * @brief      The maximum size of one allocation.
+             */
+            static constexpr std::size_t MAX_SIZE = blockSize;
+
+            /**
+             * @brief      Creates the allocator, blocks are allocated on
+             *             demand.
+             */
+            PoolAllocator() = default;
+
+            /**
+             * @brief      Type is not copyable.
+             */
+            PoolAllocator(const PoolAllocator&) = delete;
+
+            /**
+             * @brief      Type is not copyable.
+             */
+            PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+            /**
+             * @brief      Type is not movable.
+             */
+            PoolAllocator(PoolAllocator&&) = delete;
+
+            /**
+             * @brief      Type is not movable.
+             */
+            PoolAllocator& operator=(PoolAllocator&&) = delete;
+
+            /**
+             * @brief      Frees all memory. The user must ensure that none of
+             *             the blocks holds any non destructed objects.
+             */
+            ~PoolAllocator();
+
+            /**
+             * @brief      Allocates a block of uninitialized storage.
+             *             Function can be called concurrently.
+             *
+             * @param[in]  size  The size of the memory to allocate, in bytes.
+             *                   size must satisfy: 0 < size <= MAX_SIZE.
+             *
+             * @return     Pointer to allocated uninitialized memory.
+             */
+            void* allocate(std::size_t size);
+
+            /**
+             * @brief      Allocates a block of uninitialized storage. Blocks
+             *             are only aligned for fundamental types, so this
+             *             exists to give all allocators the same interface.
+             *
+             * @param[in]  size       The size of the memory to allocate, in
+             *                        bytes. size must satisfy:
+             *                        0 < size <= MAX_SIZE.
+             * @param[in]  alignment  The alignment of the memory, must be a
+             *                        power of two <= alignof(std::max_align_t).
+             *
+             * @return     Pointer to allocated uninitialized memory.
+             */
+            void* allocate(std::size_t size, std::size_t alignment);
+
+            /**
+             * @brief      Gives the block back to the allocator for reuse.
+             *             Function can be called concurrently, and from
+             *             another thread than the one allocating the block.
+             *
+             * @param      ptr   Pointer returned by allocate, or nullptr.
+             */
+            void deallocate(void* ptr);
+
+            /**
+             * @brief      Makes all blocks available for reuse, regardless of
+             *             whether they have been deallocated. User must ensure
+             *             that the destructor has been run on all stored
+             *             elements first.
+             *
+             *             Function cannot be called concurrently. As it could
+             *             result in memory corruption.
+             */
+            void clear();
+
+        private:
+            /**
+             * @brief      Header written into blocks while they are free.
+             */
+            struct FreeBlock
+            {
+                /**
+                 * @brief      Next block within the same cache or batch.
+                 */
+                FreeBlock* next{};
+
+                /**
+                 * @brief      Next batch, or block, within the global lists.
+                 *             Atomic, as it might be read by a thread losing
+                 *             the race to pop it.
+                 */
+                std::atomic<FreeBlock*> nextShared{};
+            };
+
+            using SharedList = std::atomic<nox::thread::TaggedPointer<FreeBlock>>;
+
+            /**
+             * @brief      Free blocks belonging to one thread. Padded to a
+             *             cache line to avoid false sharing between the
+             *             threads, rather than aligned, as new does not
+             *             honour over-alignment before C++17.
+             */
+            struct Cache
+            {
+                FreeBlock* first{};
+                std::size_t count{};
+                Byte padding[64 - sizeof(FreeBlock*) - sizeof(std::size_t)];
+            };
+
+            /**
+             * @brief      Size of each block, rounded up to keep every block
+             *             aligned.
+             */
+            static constexpr std::size_t BLOCK_SIZE =
+                ((blockSize > sizeof(FreeBlock) ? blockSize : sizeof(FreeBlock)) + alignof(std::max_align_t) - 1) /
+                alignof(std::max_align_t) * alignof(std::max_align_t);
+
+            /**
+             * @brief      Number of blocks moved between a cache and the
+             *             global list at once.
+             */
+            static constexpr std::size_t BATCH_SIZE = 32;
+
+            using BlockAllocator = LockFreeAllocator<BLOCK_SIZE * BATCH_SIZE * 4>;
+
+            /**
+             * @brief      Gets the cache of the thread with index, creating
+             *             it on first use.
+             */
+            Cache& getCache(std::size_t index);
+
+            /**
+             * @brief      Gets the allocator new blocks are carved from,
+             *             creating it on first use.
+             */
+            BlockAllocator& getBlocks();
+
+            /**
+             * @brief      Fills the empty cache with a batch from the global
+             *             list, or with newly carved blocks.
+             */
+            void refill(Cache& cache);
+
+            /**
+             * @brief      Pushes node onto list.
+             */
+            static void pushShared(SharedList& list, FreeBlock* node);
+
+            /**
+             * @brief      Pops the top node of list.
+             *
+             * @return     The popped node, nullptr if list was empty.
+             */
+            static FreeBlock* popShared(SharedList& list);
+
+            /**
+             * @brief      Per thread caches, indexed by ThreadIndex. Each
+             *             cache is only created and used by the thread owning
+             *             the index, so no synchronization is needed.
+             */
+            std::array<std::unique_ptr<Cache>, nox::thread::ThreadIndex::MAX_COUNT> caches{};
+
+            /**
+             * @brief      Batches of BATCH_SIZE blocks, linked through
+             *             nextShared of their first block.
+             *
+             *             Memory Order: Pushes release, and pops acquire, so
+             *             the popping thread sees the links within the batch.
+             */
+            SharedList batches{};
+
+            /**
+             * @brief      Single blocks freed by threads without an index.
+             *             Same memory ordering as batches.
+             */
+            SharedList unindexed{};
+
+            /**
+             * @brief      Where new blocks are carved from, nullptr until
+             *             the first block is needed.
+             *
+             *             Memory Order: Created with a release exchange, and
+             *             acquire loaded, so the allocator is fully constructed
+             *             before any other thread uses it.
+             */
+            std::atomic<BlockAllocator*> blocks{nullptr};
+        };
+    }
+}
+
+#include <nox/memory/PoolAllocator.tpp>
+
+#endif
@@ -0,0 +1,211 @@
+#include <new>
+
+#include <nox/memory/alignment.h>
+#include <nox/util/nox_assert.h>
+
+template<std::size_t blockSize>
+nox::memory::PoolAllocator<blockSize>::~PoolAllocator()
+{
+    delete this->blocks.load(std::memory_order_acquire);
+}
+
+template<std::size_t blockSize>
+void*
+nox::memory::PoolAllocator<blockSize>::allocate(const std::size_t size)
+{
+    NOX_ASSERT(size > 0 && size <= MAX_SIZE, "param size must satisfy 0 < size <= MAX_SIZE, size was: %zu", size);
+
+    const auto index = nox::thread::ThreadIndex::get();
+    if (index == nox::thread::ThreadIndex::INVALID)
+    {
+        auto block = popShared(this->unindexed);
+        return (block) ? static_cast<void*>(block) : this->getBlocks().allocate(BLOCK_SIZE, alignof(std::max_align_t));
+    }
+
+    auto& cache = this->getCache(index);
+    if (!cache.first)
+    {
+        this->refill(cache);
+    }
+
+    auto block = cache.first;
+    cache.first = block->next;
+    --cache.count;
+
+    return block;
+}
+
+template<std::size_t blockSize>
+void*
+nox::memory::PoolAllocator<blockSize>::allocate(const std::size_t size, const std::size_t alignment)
+{
+    NOX_ASSERT(isValidAlignment(alignment) && alignment <= alignof(std::max_align_t),
+               "Alignment must be a power of two <= alignof(std::max_align_t), alignment was: %zu", alignment);
+    return this->allocate(size);
+}
+
+template<std::size_t blockSize>
+void
+nox::memory::PoolAllocator<blockSize>::deallocate(void* ptr)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    auto block = new (ptr) FreeBlock();
+
+    const auto index = nox::thread::ThreadIndex::get();
+    if (index == nox::thread::ThreadIndex::INVALID)
+    {
+        pushShared(this->unindexed, block);
+        return;
+    }
+
+    auto& cache = this->getCache(index);
+    block->next = cache.first;
+    cache.first = block;
+    ++cache.count;
+
+    // Keep one batch around, so a thread alternating between allocating
+    // and deallocating at the limit doesn't hit the global list every time.
+    if (cache.count >= BATCH_SIZE * 2)
+    {
+        auto last = cache.first;
+        for (std::size_t i = 1; i < BATCH_SIZE; ++i)
+        {
+            last = last->next;
+        }
+
+        auto batch = cache.first;
+        cache.first = last->next;
+        cache.count -= BATCH_SIZE;
+        last->next = nullptr;
+
+        pushShared(this->batches, batch);
+    }
+}
+
+template<std::size_t blockSize>
+void
+nox::memory::PoolAllocator<blockSize>::clear()
+{
+    for (auto& cache : this->caches)
+    {
+        if (cache)
+        {
+            cache->first = nullptr;
+            cache->count = 0;
+        }
+    }
+
+    const auto batches = this->batches.load(std::memory_order_relaxed);
+    this->batches.store(batches.next(nullptr), std::memory_order_relaxed);
+
+    const auto unindexed = this->unindexed.load(std::memory_order_relaxed);
+    this->unindexed.store(unindexed.next(nullptr), std::memory_order_relaxed);
+
+    const auto blocks = this->blocks.load(std::memory_order_acquire);
+    if (blocks)
+    {
+        blocks->clear();
+    }
+}
+
+template<std::size_t blockSize>
+typename nox::memory::PoolAllocator<blockSize>::Cache&
+nox::memory::PoolAllocator<blockSize>::getCache(std::size_t index)
+{
+    auto& cache = this->caches[index];
+    if (!cache)
+    {
+        cache = std::make_unique<Cache>();
+    }
+    return *cache;
+}
+
+template<std::size_t blockSize>
+typename nox::memory::PoolAllocator<blockSize>::BlockAllocator&
+nox::memory::PoolAllocator<blockSize>::getBlocks()
+{
+    auto blocks = this->blocks.load(std::memory_order_acquire);
+    if (!blocks)
+    {
+        // Several threads might race to create the allocator, the losers delete theirs.
+        auto desired = new BlockAllocator();
+        if (this->blocks.compare_exchange_strong(blocks,
+                                                 desired,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_acquire))
+        {
+            blocks = desired;
+        }
+        else
+        {
+            delete desired;
+        }
+    }
+    return *blocks;
+}
+
+template<std::size_t blockSize>
+void
+nox::memory::PoolAllocator<blockSize>::refill(Cache& cache)
+{
+    auto batch = popShared(this->batches);
+    if (batch)
+    {
+        cache.first = batch;
+        cache.count = BATCH_SIZE;
+        return;
+    }
+
+    auto memory = static_cast<Byte*>(this->getBlocks().allocate(BLOCK_SIZE * BATCH_SIZE, alignof(std::max_align_t)));
+
+    FreeBlock* next = nullptr;
+    for (std::size_t i = BATCH_SIZE; i > 0; --i)
+    {
+        auto block = new (memory + (i - 1) * BLOCK_SIZE) FreeBlock();
+        block->next = next;
+        next = block;
+    }
+
+    cache.first = next;
+    cache.count = BATCH_SIZE;
+}
+
+template<std::size_t blockSize>
+void
+nox::memory::PoolAllocator<blockSize>::pushShared(SharedList& list, FreeBlock* node)
+{
+    auto current = list.load(std::memory_order_relaxed);
+    do
+    {
+        node->nextShared.store(current.getPointer(), std::memory_order_relaxed);
+    } while (!list.compare_exchange_weak(current,
+                                         current.next(node),
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed));
+}
+
+template<std::size_t blockSize>
+typename nox::memory::PoolAllocator<blockSize>::FreeBlock*
+nox::memory::PoolAllocator<blockSize>::popShared(SharedList& list)
+{
+    auto current = list.load(std::memory_order_acquire);
+    while (current.getPointer())
+    {
+        // The node might be popped and handed out before our exchange, in which case
+        // nextShared is garbage, but the tag will have changed and the exchange fails.
+        auto next = current.getPointer()->nextShared.load(std::memory_order_relaxed);
+        if (list.compare_exchange_weak(current,
+                                       current.next(next),
+                                       std::memory_order_acquire,
+                                       std::memory_order_acquire))
+        {
+            return current.getPointer();
+        }
+    }
+
+    return nullptr;
+}
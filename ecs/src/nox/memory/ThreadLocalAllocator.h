@@ -0,0 +1,186 @@
+#ifndef NOX_MEMORY_THREADLOCALALLOCATOR_H_
+#define NOX_MEMORY_THREADLOCALALLOCATOR_H_
+#include <array>
+#include <cstddef>
+#include <memory>
+
+#include <nox/memory/LinearAllocator.h>
+#include <nox/memory/LockFreeAllocator.h>
+#include <nox/thread/ThreadIndex.h>
+
+namespace nox
+{
+    namespace memory
+    {
+        /**
+         * @brief      A thread safe linear allocator where every thread
+         *             allocates from its own arena. Like the other linear
+         *             allocators, memory cannot be deallocated on the fly,
+         *             but is reclaimed for all threads at once through clear.
+         *
+         * @detail     Each thread (see nox::thread::ThreadIndex) gets a
+         *             LinearAllocator the first time it allocates, which only
+         *             that thread touches until clear. Allocating is therefore
+         *             a plain bump of a counter no other core writes to, at
+         *             the cost of one partially used block per thread.
+         *             Threads without an index fall back to a shared
+         *             LockFreeAllocator.
+         *
+         *             Allocations are split into two size classes, each with
+         *             its own arena. Allocations up to SMALL_SIZE bytes go
+         *             into blocks of blockSize, larger ones into blocks of
+         *             largeBlockSize, so a few big allocations neither waste
+         *             most of a small block, nor need a separate heap
+         *             allocation.
+         *
+         * @tparam     blockSize       The size of each block for small
+         *                             allocations.
+         * @tparam     largeBlockSize  The size of each block for large
+         *                             allocations, and the maximum size of
+         *                             one allocation.
+         */
+        template<std::size_t blockSize, std::size_t largeBlockSize = blockSize * 64>
+        class ThreadLocalAllocator
+        {
+        public:
+            /**
+             * @brief      The maximum size of one allocation.
+             */
+            static constexpr std::size_t MAX_SIZE = largeBlockSize;
+
+            /**
+             * @brief      Allocations, including padding, larger than this
+             *             go into the large blocks. Keeps the space wasted at
+             *             the end of a small block below a quarter of it.
+             */
+            static constexpr std::size_t SMALL_SIZE = blockSize / 4;
+
+            /**
+             * @brief      Creates the allocator, arenas are created on demand.
+             */
+            ThreadLocalAllocator() = default;
+
+            /**
+             * @brief      Type is not copyable.
+             */
+            ThreadLocalAllocator(const ThreadLocalAllocator&) = delete;
+
+            /**
+             * @brief      Type is not copyable.
+             */
+            ThreadLocalAllocator& operator=(const ThreadLocalAllocator&) = delete;
+
+            /**
+             * @brief      Type is not movable.
+             */
+            ThreadLocalAllocator(ThreadLocalAllocator&&) = delete;
+
+            /**
+             * @brief      Type is not movable.
+             */
+            ThreadLocalAllocator& operator=(ThreadLocalAllocator&&) = delete;
+
+            /**
+             * @brief      Allocates size bytes of uninitialized storage from
+             *             the arena of the calling thread, within the size
+             *             class of size.
+             *             Function can be called concurrently.
+             *
+             * @param[in]  size  The size of the memory to allocate, in bytes.
+             *                   size must satisfy: 0 < size <= MAX_SIZE.
+             *
+             * @return     Pointer to allocated uninitialized memory.
+             */
+            void* allocate(std::size_t size);
+
+            /**
+             * @brief      Allocates size bytes of uninitialized storage aligned
+             *             to alignment, from the arena of the calling thread,
+             *             within the size class of size.
+             *             Function can be called concurrently.
+             *
+             * @param[in]  size       The size of the memory to allocate, in
+             *                        bytes. size must satisfy: 0 < size and
+             *                        size + getWorstCasePadding(alignment) <=
+             *                        MAX_SIZE.
+             * @param[in]  alignment  The alignment of the memory, must be a
+             *                        power of two.
+             *
+             * @return     Pointer to allocated uninitialized memory.
+             */
+            void* allocate(std::size_t size, std::size_t alignment);
+
+            /**
+             * @brief      Returns the most padding an allocation with the
+             *             given alignment can need in an empty block.
+             *
+             * @param[in]  alignment  The alignment, must be a power of two.
+             *
+             * @return     The padding in bytes.
+             */
+            static constexpr std::size_t getWorstCasePadding(std::size_t alignment);
+
+            /**
+             * @brief      Function is ignored in this allocator. The function
+             *             exists only reason for easing performance testing in
+             *             real world case. See:
+             *             https://github.com/Per-Morten/imt3912_dev/issues/81
+             *
+             * @param      ptr   Ignored!
+             */
+            void deallocate(void* /*ptr*/) {}
+
+            /**
+             * @brief      Prepares the arenas of all threads for reuse. User
+             *             must ensure that the destructor has been run on all
+             *             stored elements first.
+             *
+             *             Function cannot be called concurrently, neither
+             *             with itself nor with allocate.
+             */
+            void clear();
+
+        private:
+            /**
+             * @brief      The arena of one thread. Aligned to avoid false
+             *             sharing between the threads.
+             */
+            struct alignas(64) Arena
+            {
+                std::unique_ptr<LinearAllocator<blockSize>> small{};
+                std::unique_ptr<LinearAllocator<largeBlockSize>> large{};
+            };
+
+            static_assert(SMALL_SIZE > 0 && blockSize <= largeBlockSize,
+                          "Large blocks must be at least as big as the small blocks");
+
+            /**
+             * @brief      Gets the arena of the calling thread.
+             *
+             * @return     The arena, nullptr if the thread has no index.
+             */
+            Arena* getArena();
+
+            /**
+             * @brief      Per thread arenas, indexed by ThreadIndex. Each
+             *             arena is only created and used by the thread owning
+             *             the index, so no synchronization is needed.
+             */
+            std::array<Arena, nox::thread::ThreadIndex::MAX_COUNT> arenas{};
+
+            /**
+             * @brief      Small allocations of threads without an index.
+             */
+            LockFreeAllocator<blockSize> unindexedSmall{};
+
+            /**
+             * @brief      Large allocations of threads without an index.
+             */
+            LockFreeAllocator<largeBlockSize> unindexedLarge{};
+        };
+    }
+}
+
+#include <nox/memory/ThreadLocalAllocator.tpp>
+
+#endif
@@ -0,0 +1,76 @@
+template<std::size_t blockSize, std::size_t largeBlockSize>
+void*
+nox::memory::ThreadLocalAllocator<blockSize, largeBlockSize>::allocate(const std::size_t size)
+{
+    return this->allocate(size, 1);
+}
+
+template<std::size_t blockSize, std::size_t largeBlockSize>
+void*
+nox::memory::ThreadLocalAllocator<blockSize, largeBlockSize>::allocate(const std::size_t size,
+                                                                       const std::size_t alignment)
+{
+    const bool isSmall = size + getWorstCasePadding(alignment) <= SMALL_SIZE;
+
+    auto arena = this->getArena();
+    if (!arena)
+    {
+        return (isSmall)
+            ? this->unindexedSmall.allocate(size, alignment)
+            : this->unindexedLarge.allocate(size, alignment);
+    }
+
+    // Arenas are only ever touched by the thread owning them, so they are created lazily.
+    if (isSmall)
+    {
+        if (!arena->small)
+        {
+            arena->small = std::make_unique<LinearAllocator<blockSize>>();
+        }
+        return arena->small->allocate(size, alignment);
+    }
+
+    if (!arena->large)
+    {
+        arena->large = std::make_unique<LinearAllocator<largeBlockSize>>();
+    }
+    return arena->large->allocate(size, alignment);
+}
+
+template<std::size_t blockSize, std::size_t largeBlockSize>
+constexpr std::size_t
+nox::memory::ThreadLocalAllocator<blockSize, largeBlockSize>::getWorstCasePadding(const std::size_t alignment)
+{
+    return LinearAllocator<largeBlockSize>::getWorstCasePadding(alignment);
+}
+
+template<std::size_t blockSize, std::size_t largeBlockSize>
+void
+nox::memory::ThreadLocalAllocator<blockSize, largeBlockSize>::clear()
+{
+    for (auto& arena : this->arenas)
+    {
+        if (arena.small)
+        {
+            arena.small->clear();
+        }
+        if (arena.large)
+        {
+            arena.large->clear();
+        }
+    }
+    this->unindexedSmall.clear();
+    this->unindexedLarge.clear();
+}
+
+template<std::size_t blockSize, std::size_t largeBlockSize>
+typename nox::memory::ThreadLocalAllocator<blockSize, largeBlockSize>::Arena*
+nox::memory::ThreadLocalAllocator<blockSize, largeBlockSize>::getArena()
+{
+    const auto index = nox::thread::ThreadIndex::get();
+    if (index == nox::thread::ThreadIndex::INVALID)
+    {
+        return nullptr;
+    }
+    return &this->arenas[index];
+}
@@ -0,0 +1,44 @@
+#ifndef NOX_MEMORY_ALIGNMENT_H_
+#define NOX_MEMORY_ALIGNMENT_H_
+#include <cstddef>
+#include <cstdint>
+
+namespace nox
+{
+    namespace memory
+    {
+        /**
+         * @brief      Checks if alignment is a valid alignment, i.e. a power
+         *             of two.
+         *
+         * @param[in]  alignment  The alignment to check.
+         *
+         * @return     true if alignment is a power of two, false otherwise.
+         */
+        constexpr
+        bool
+        isValidAlignment(std::size_t alignment)
+        {
+            return alignment != 0 && (alignment & (alignment - 1)) == 0;
+        }
+
+        /**
+         * @brief      Gets the number of bytes that must be skipped from
+         *             address to reach the next address aligned to alignment.
+         *
+         * @param[in]  address    The address to align.
+         * @param[in]  alignment  The alignment, must be a power of two.
+         *
+         * @return     The padding in bytes, 0 if address is already aligned.
+         */
+        inline
+        std::size_t
+        getAlignmentPadding(const void* address, std::size_t alignment)
+        {
+            const auto value = reinterpret_cast<std::uintptr_t>(address);
+            return static_cast<std::size_t>((alignment - (value & (alignment - 1))) & (alignment - 1));
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef NOX_THREAD_BOUNDEDQUEUE_H_
+#define NOX_THREAD_BOUNDEDQUEUE_H_
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace nox
+{
+    namespace thread
+    {
+        /**
+         * @brief      Bounded lock-free multiple-producer multiple-consumer
+         *             FIFO queue, built on a ring buffer where every cell
+         *             holds a sequence number telling whether it is ready to
+         *             be written or read (Vyukov). Apart from the buffer
+         *             allocated on construction, the queue never allocates.
+         *
+         * @detail     Offers the same push, pop and clear functions as
+         *             LockFreeStack and LockedQueue, and can be used as the
+         *             QueueType of nox::thread::Pool, as long as tasks don't
+         *             add more tasks than the capacity.
+         *
+         * @warning    push blocks while the queue is full, waiting for a
+         *             consumer to pop. Use tryPush if no other thread is
+         *             guaranteed to be consuming. It is therefore not a
+         *             drop-in container for the requests of the
+         *             EntityManager, which are only consumed by the step
+         *             functions running on the thread that might be pushing.
+         *
+         * @tparam     T     Must be move constructible and move assignable.
+         *
+         * @see        http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+         */
+        template<class T>
+        class BoundedQueue
+        {
+        public:
+            static_assert(std::is_move_assignable<T>::value, "Type T must be move assignable");
+
+            /**
+             * @brief      The capacity used if none is given.
+             */
+            static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+            /**
+             * @brief      Creates the queue.
+             *
+             * @param[in]  capacity  The minimum number of elements the queue
+             *                       can hold, rounded up to a power of two.
+             */
+            BoundedQueue(std::size_t capacity = DEFAULT_CAPACITY);
+
+            /**
+             * @brief      As a result of the atomics, the type is non-copy-constructible.
+             */
+            BoundedQueue(const BoundedQueue&) = delete;
+
+            /**
+             * @brief      As a result of the atomics, the type is non-copy-assignable.
+             */
+            BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+            /**
+             * @brief      As a result of the atomics, the type is non-move-constructible.
+             */
+            BoundedQueue(BoundedQueue&&) = delete;
+
+            /**
+             * @brief      As a result of the atomics, the type is non-move-assignable.
+             */
+            BoundedQueue& operator=(BoundedQueue&&) = delete;
+
+            /**
+             * @brief      Destroys the elements left in the queue.
+             */
+            ~BoundedQueue();
+
+            /**
+             * @brief      Pushes the value onto the back of the queue, yielding
+             *             while the queue is full.
+             *
+             * @param[in]  value  The value to push onto the queue.
+             */
+            void
+            push(const T& value);
+
+            /**
+             * @brief      Pushes the value onto the back of the queue, yielding
+             *             while the queue is full.
+             *
+             * @param[in]  value  The value to push onto the queue, it will be
+             *                    moved from.
+             */
+            void
+            push(T&& value);
+
+            /**
+             * @brief      Pushes the value onto the back of the queue if it is
+             *             not full.
+             *
+             * @param[in]  value  The value to push onto the queue.
+             *
+             * @return     True if the value was pushed, false if the queue
+             *             was full.
+             */
+            bool
+            tryPush(const T& value);
+
+            /**
+             * @brief      Pushes the value onto the back of the queue if it is
+             *             not full.
+             *
+             * @param[in]  value  The value to push onto the queue, it is only
+             *                    moved from if the push succeeds.
+             *
+             * @return     True if the value was pushed, false if the queue
+             *             was full.
+             */
+            bool
+            tryPush(T&& value);
+
+            /**
+             * @brief      Pops the front value of the queue if possible and
+             *             move assigns it to value.
+             *
+             * @param[out] value  The value to store the popped value in. If no
+             *                    value could be popped, value is left
+             *                    unchanged.
+             *
+             * @return     True if a value was popped, false if the queue was
+             *             empty.
+             */
+            bool
+            pop(T& value);
+
+            /**
+             * @brief      Removes and destroys all the elements in the queue
+             *             at the point in time the function was called.
+             */
+            void
+            clear();
+
+            /**
+             * @brief      Returns the number of elements the queue can hold.
+             *
+             * @return     The capacity of the queue.
+             */
+            std::size_t
+            capacity() const;
+
+        private:
+            struct Cell
+            {
+                /**
+                 * @brief      Equal to the position of the cell when it is
+                 *             ready to be written, position + 1 when ready to
+                 *             be read, and position + capacity once read.
+                 *
+                 *             Memory Order: Stored with release after the
+                 *             value is constructed or destroyed, and loaded
+                 *             with acquire before touching the value.
+                 */
+                std::atomic<std::size_t> sequence{};
+
+                typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+            };
+
+            /**
+             * @brief      Claims a cell and constructs the value in it.
+             *
+             * @return     False if the queue was full.
+             */
+            template<class U>
+            bool
+            emplace(U&& value);
+
+            /**
+             * @brief      Claims the front cell, calls function(element) on
+             *             its element, and destroys the element.
+             *
+             * @return     False if the queue was empty.
+             */
+            template<class Function>
+            bool
+            consume(const Function& function);
+
+            std::unique_ptr<Cell[]> cells{};
+            std::size_t mask{};
+
+            /**
+             * @brief      Position of the next cell to write and read. Only
+             *             used to claim cells, all synchronization goes
+             *             through the sequence of each cell, so the ordering
+             *             is relaxed. Placed on separate cache lines, so
+             *             producers and consumers don't interfere.
+             */
+            alignas(64) std::atomic<std::size_t> enqueuePosition{0};
+            alignas(64) std::atomic<std::size_t> dequeuePosition{0};
+        };
+    }
+}
+
+#include <nox/thread/BoundedQueue.tpp>
+
+#endif
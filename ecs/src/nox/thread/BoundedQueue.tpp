@@ -0,0 +1,167 @@
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <utility>
+
+template<class T>
+nox::thread::BoundedQueue<T>::BoundedQueue(std::size_t capacity)
+{
+    std::size_t size = 2;
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+
+    this->cells = std::make_unique<Cell[]>(size);
+    this->mask = size - 1;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        this->cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<class T>
+nox::thread::BoundedQueue<T>::~BoundedQueue()
+{
+    this->clear();
+}
+
+template<class T>
+void
+nox::thread::BoundedQueue<T>::push(const T& value)
+{
+    while (!this->emplace(value))
+    {
+        std::this_thread::yield();
+    }
+}
+
+template<class T>
+void
+nox::thread::BoundedQueue<T>::push(T&& value)
+{
+    while (!this->emplace(std::move(value)))
+    {
+        std::this_thread::yield();
+    }
+}
+
+template<class T>
+bool
+nox::thread::BoundedQueue<T>::tryPush(const T& value)
+{
+    return this->emplace(value);
+}
+
+template<class T>
+bool
+nox::thread::BoundedQueue<T>::tryPush(T&& value)
+{
+    return this->emplace(std::move(value));
+}
+
+template<class T>
+bool
+nox::thread::BoundedQueue<T>::pop(T& value)
+{
+    return this->consume([&value](T& element) { value = std::move(element); });
+}
+
+template<class T>
+void
+nox::thread::BoundedQueue<T>::clear()
+{
+    while (this->consume([](T&) {}))
+    {
+    }
+}
+
+template<class T>
+std::size_t
+nox::thread::BoundedQueue<T>::capacity() const
+{
+    return this->mask + 1;
+}
+
+template<class T>
+template<class U>
+bool
+nox::thread::BoundedQueue<T>::emplace(U&& value)
+{
+    Cell* cell = nullptr;
+    auto position = this->enqueuePosition.load(std::memory_order_relaxed);
+    while (true)
+    {
+        cell = &this->cells[position & this->mask];
+        const auto sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+        if (difference == 0)
+        {
+            if (this->enqueuePosition.compare_exchange_weak(position,
+                                                            position + 1,
+                                                            std::memory_order_relaxed,
+                                                            std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The cell has not been read since its last write, the queue is full.
+            return false;
+        }
+        else
+        {
+            position = this->enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    new (&cell->storage) T(std::forward<U>(value));
+
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template<class T>
+template<class Function>
+bool
+nox::thread::BoundedQueue<T>::consume(const Function& function)
+{
+    Cell* cell = nullptr;
+    auto position = this->dequeuePosition.load(std::memory_order_relaxed);
+    while (true)
+    {
+        cell = &this->cells[position & this->mask];
+        const auto sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+
+        if (difference == 0)
+        {
+            if (this->dequeuePosition.compare_exchange_weak(position,
+                                                            position + 1,
+                                                            std::memory_order_relaxed,
+                                                            std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The cell has not been written since its last read, the queue is empty.
+            return false;
+        }
+        else
+        {
+            position = this->dequeuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    auto element = reinterpret_cast<T*>(&cell->storage);
+    function(*element);
+    element->~T();
+
+    cell->sequence.store(position + this->mask + 1, std::memory_order_release);
+    return true;
+}
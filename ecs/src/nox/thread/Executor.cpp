@@ -0,0 +1,12 @@
+#include <nox/thread/Executor.h>
+
+#include <utility>
+
+void
+nox::thread::Executor::addTasks(Task* first, Task* last, TaskGroup& group)
+{
+    for (; first != last; ++first)
+    {
+        this->addTask(std::move(*first), group);
+    }
+}
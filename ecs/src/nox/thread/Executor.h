@@ -0,0 +1,72 @@
+#ifndef NOX_THREAD_EXECUTOR_H_
+#define NOX_THREAD_EXECUTOR_H_
+#include <cstddef>
+
+#include <nox/thread/Task.h>
+#include <nox/thread/TaskGroup.h>
+
+namespace nox
+{
+    namespace thread
+    {
+        /**
+         * @brief      Interface for anything able to run tasks on behalf of
+         *             the ECS, allowing several EntityManagers to share one
+         *             pool, or the host application to run the work on its
+         *             own job system.
+         *
+         * @detail     Implemented by nox::thread::Pool and
+         *             nox::thread::WorkStealingPool. An implementation must
+         *             allow wait to be called from within a task without
+         *             deadlocking, i.e. by running tasks while waiting.
+         */
+        class Executor
+        {
+        public:
+            virtual ~Executor() = default;
+
+            /**
+             * @brief      Adds a task to be run as part of group.
+             *
+             * @param[in]  task   The task to run.
+             * @param[in]  group  The group the task belongs to, must outlive
+             *                    the task.
+             */
+            virtual void
+            addTask(Task task, TaskGroup& group) = 0;
+
+            /**
+             * @brief      Adds all the tasks in the range [first, last) to be
+             *             run as part of group. The tasks are moved from.
+             *             Defaults to calling addTask for each task.
+             *
+             * @param[in]  first  Pointer to the first task to add.
+             * @param[in]  last   Pointer to one past the last task to add.
+             * @param[in]  group  The group the tasks belong to, must outlive
+             *                    the tasks.
+             */
+            virtual void
+            addTasks(Task* first, Task* last, TaskGroup& group);
+
+            /**
+             * @brief      Blocking function, returns when all the tasks in
+             *             group have been run.
+             *
+             * @param[in]  group  The group to wait for.
+             */
+            virtual void
+            wait(const TaskGroup& group) = 0;
+
+            /**
+             * @brief      Returns the number of threads running tasks, not
+             *             counting the threads waiting.
+             *
+             * @return     Number of threads running tasks.
+             */
+            virtual std::size_t
+            threadCount() const = 0;
+        };
+    }
+}
+
+#endif
@@ -1,8 +1,10 @@
 #ifndef NOX_THREAD_LOCKFREESTACK_H_
 #define NOX_THREAD_LOCKFREESTACK_H_
 #include <atomic>
+#include <type_traits>
 
-#include <nox/memory/LockFreeAllocator.h>
+#include <nox/memory/PoolAllocator.h>
+#include <nox/thread/TaggedPointer.h>
 
 namespace nox
 {
@@ -10,10 +12,18 @@ namespace nox
     {
         /**
          * @brief      A minimalistic implementation of a lock-free stack. The
-         *             stack can be pushed to, popped from, and cleared. The
-         *             stack should work for a multiple-producer
-         *             multiple-consumer case, however it has only been tested
-         *             in a multiple-producer single-consumer case.
+         *             stack can be pushed to, popped from, and cleared, all
+         *             concurrently, from multiple producers and consumers.
+         *
+         * @detail     The head of the stack is a TaggedPointer, making the
+         *             compare exchange in pop fail if the head has been popped
+         *             and pushed again in the meantime (the ABA problem).
+         *             Popped nodes are recycled through a PoolAllocator owned
+         *             by the stack, which never gives memory back before the
+         *             stack is destroyed. This keeps reading the next pointer
+         *             of a node popped by another thread safe, and bounds the
+         *             memory use to the largest number of elements held at
+         *             once.
          *
          * @tparam     T     Must be of move assignable type, as the pop
          *                   function uses move to into value.
@@ -91,32 +101,56 @@ namespace nox
             pop(T& value);
 
             /**
-             * @brief      Removes and deallocates all the memory used in the
-             *             stack at the point in time the function was called.
-             *            
-             * @warning    Function cannot be called concurrently with push,
-             *             as this could corrupt memory with the linear allocator.
+             * @brief      Removes and destroys all the elements in the stack at
+             *             the point in time the function was called. The nodes
+             *             are given back to the allocator for reuse.
              */
             void
             clear();
 
         private:
-            struct Node 
+            /**
+             * @brief      Node within the stack. The value is constructed on
+             *             push and destroyed on pop.
+             */
+            struct Node
             {
-                Node(T value)
-                    : value(std::move(value))
-                {
-                }
+                /**
+                 * @brief      Atomic, as it might be read by a thread losing
+                 *             the race to pop the node, while the winner
+                 *             reuses it.
+                 */
+                std::atomic<Node*> next{};
+
+                typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
 
-                Node* next{};
-                T value;
+                T* value();
             };
 
-            using Allocator = nox::memory::LockFreeAllocator<sizeof(Node) * 128>;
+            /**
+             * @brief      Pushes node onto the stack.
+             */
+            void pushNode(Node* node);
+
+            /**
+             * @brief      Pops the top node of the stack.
+             *
+             * @return     The popped node, nullptr if the stack was empty.
+             */
+            Node* popNode();
+
+            using Allocator = nox::memory::PoolAllocator<sizeof(Node)>;
 
             Allocator allocator{};
 
-            std::atomic<Node*> head{};
+            /**
+             * @brief      Top of the stack.
+             *
+             *             Memory Order: Pushes release, and pops acquire, so
+             *             the popping thread sees the value constructed by the
+             *             pushing thread.
+             */
+            std::atomic<TaggedPointer<Node>> head{};
         };
     }
 }
@@ -1,3 +1,6 @@
+#include <new>
+#include <utility>
+
 template<class T>
 nox::thread::LockFreeStack<T>::~LockFreeStack()
 {
@@ -8,56 +11,33 @@ template<class T>
 void
 nox::thread::LockFreeStack<T>::push(const T& value)
 {
-    auto memory = this->allocator.allocate(sizeof(Node));
-    auto newHead = new (memory) Node(value);
-
-    newHead->next = this->head.load(std::memory_order_relaxed);
-
-    while (!head.compare_exchange_weak(newHead->next,
-                                       newHead,
-                                       std::memory_order_release,
-                                       std::memory_order_relaxed))
-    {
-    }
+    auto node = new (this->allocator.allocate(sizeof(Node))) Node();
+    new (&node->storage) T(value);
+    this->pushNode(node);
 }
 
 template<class T>
 void
 nox::thread::LockFreeStack<T>::push(T&& value)
 {
-    auto memory = this->allocator.allocate(sizeof(Node));
-    auto newHead = new (memory) Node(std::move(value));
-
-    newHead->next = this->head.load(std::memory_order_relaxed);
-
-    while (!head.compare_exchange_weak(newHead->next,
-                                       newHead,
-                                       std::memory_order_release,
-                                       std::memory_order_relaxed))
-    {
-    }
+    auto node = new (this->allocator.allocate(sizeof(Node))) Node();
+    new (&node->storage) T(std::move(value));
+    this->pushNode(node);
 }
 
 template<class T>
 bool
 nox::thread::LockFreeStack<T>::pop(T& value)
 {
-    auto expected = this->head.load(std::memory_order_acquire);
-    if (!expected)
+    auto node = this->popNode();
+    if (!node)
     {
         return false;
     }
 
-    while (!head.compare_exchange_weak(expected,
-                                       expected->next,
-                                       std::memory_order_release,
-                                       std::memory_order_relaxed))
-    {
-    }
-
-    value = std::move(expected->value);
-    expected->~Node();
-    this->allocator.deallocate(expected);
+    value = std::move(*node->value());
+    node->value()->~T();
+    this->allocator.deallocate(node);
 
     return true;
 }
@@ -66,12 +46,52 @@ template<class T>
 void
 nox::thread::LockFreeStack<T>::clear()
 {
-    auto itr = this->head.exchange(nullptr, std::memory_order_acq_rel);
-    while (itr)
+    while (auto node = this->popNode())
+    {
+        node->value()->~T();
+        this->allocator.deallocate(node);
+    }
+}
+
+template<class T>
+T*
+nox::thread::LockFreeStack<T>::Node::value()
+{
+    return reinterpret_cast<T*>(&this->storage);
+}
+
+template<class T>
+void
+nox::thread::LockFreeStack<T>::pushNode(Node* node)
+{
+    auto current = this->head.load(std::memory_order_relaxed);
+    do
+    {
+        node->next.store(current.getPointer(), std::memory_order_relaxed);
+    } while (!this->head.compare_exchange_weak(current,
+                                               current.next(node),
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed));
+}
+
+template<class T>
+typename nox::thread::LockFreeStack<T>::Node*
+nox::thread::LockFreeStack<T>::popNode()
+{
+    auto current = this->head.load(std::memory_order_acquire);
+    while (current.getPointer())
     {
-        itr->~Node();
-        this->allocator.deallocate(itr);
+        // The node might be popped and reused before our exchange, in which case
+        // next is garbage, but the tag will have changed and the exchange fails.
+        auto next = current.getPointer()->next.load(std::memory_order_relaxed);
+        if (this->head.compare_exchange_weak(current,
+                                             current.next(next),
+                                             std::memory_order_acquire,
+                                             std::memory_order_acquire))
+        {
+            return current.getPointer();
+        }
     }
 
-    this->allocator.clear();
+    return nullptr;
 }
@@ -2,8 +2,14 @@
 #define NOX_THREAD_POOL_H_
 #include <atomic>
 #include <condition_variable>
+#include <mutex>
 #include <thread>
-#include <functional>
+#include <vector>
+
+#include <nox/thread/Executor.h>
+#include <nox/thread/setThreadAffinity.h>
+#include <nox/thread/Task.h>
+#include <nox/thread/TaskGroup.h>
 
 namespace nox
 {
@@ -23,20 +29,30 @@ namespace nox
          *
          *             void clear(), removes all elements.
          *
-         *             void push(const reference value), pushes value onto the
+         *             void push(value_type&& value), pushes value onto the
          *             back of the queue.
+         *
+         *             The queue is instantiated with an internal job type
+         *             holding the task and its group.
+         *
+         *             LockFreeStack, LockedQueue and BoundedQueue satisfy
+         *             these requirements. With BoundedQueue, adding tasks
+         *             blocks while the queue is full, so the pool must have
+         *             at least one thread, and tasks must not add tasks,
+         *             e.g. through parallelFor, parallelInvoke or a
+         *             TaskGroup, since every thread might end up waiting
+         *             for room in the queue.
          */
         template<template <class> class QueueType>
         class Pool
+            : public nox::thread::Executor
         {
         public:
             /**
-             * @brief      Currently the task is just a std::function, might be
-             *             turned into a regular function ptr or something in
-             *             the future. Depends on how it integrates with the
-             *             EntityManager.
+             * @brief      Move-only task, storing the callable inline so that
+             *             adding a task never allocates.
              */
-            using Task = std::function<void(void)>;
+            using Task = nox::thread::Task;
 
             /**
              * @brief      Creates a pool with the given number of threads. If
@@ -44,9 +60,16 @@ namespace nox
              *             many threads are available and creates that amount,
              *             minimum one.
              *
+             *             If cpuAffinity is given, thread i is pinned to CPU
+             *             cpuAffinity[i % cpuAffinity.size()]. Pinning is best
+             *             effort, and ignored where it is unsupported.
+             *
              * @param[in]  threadCount  The number of threads in the pool.
+             * @param[in]  cpuAffinity  The CPUs to pin the threads to, empty
+             *                          leaves the threads unpinned.
              */
-            Pool(std::size_t threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1u);
+            Pool(std::size_t threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1u,
+                 const std::vector<std::size_t>& cpuAffinity = {});
 
             /**
              * @brief      Copy constructing thread pool is illegal because of the
@@ -77,36 +100,128 @@ namespace nox
              *             before joining the threads. All tasks left in the
              *             queue is discarded.
              */
-            ~Pool();
+            virtual ~Pool() override;
 
             /**
              * @brief      Adds a task to the queue of tasks to be finished.
              *
              * @param[in]  task  The task to run.
              */
-            void addTask(const Task& task);
+            void addTask(Task task);
+
+            /**
+             * @brief      Adds all the tasks in the range [first, last) to the
+             *             queue of tasks to be finished, waking the workers
+             *             once for the whole batch instead of once per task.
+             *
+             * @param[in]  first     Iterator to the first task to add.
+             * @param[in]  last      Iterator to one past the last task to add.
+             *
+             * @tparam     Iterator  Forward iterator to Task, the tasks are
+             *                       moved from.
+             */
+            template<class Iterator>
+            void addTasks(Iterator first, Iterator last);
+
+            /**
+             * @brief      Adds a task to the queue of tasks to be finished, as
+             *             part of group.
+             *
+             * @param[in]  task   The task to run.
+             * @param[in]  group  The group the task belongs to, must outlive
+             *                    the task.
+             */
+            virtual void addTask(Task task, TaskGroup& group) override;
+
+            /**
+             * @brief      Adds all the tasks in the range [first, last) to the
+             *             queue of tasks to be finished, as part of group.
+             *
+             * @param[in]  first     Iterator to the first task to add.
+             * @param[in]  last      Iterator to one past the last task to add.
+             * @param[in]  group     The group the tasks belong to, must
+             *                       outlive the tasks.
+             *
+             * @tparam     Iterator  Forward iterator to Task, the tasks are
+             *                       moved from.
+             */
+            template<class Iterator>
+            void addTasks(Iterator first, Iterator last, TaskGroup& group);
 
             /**
-             * @brief      Removes all the tasks from the taskQueue.
+             * @brief      Adds all the tasks in the range [first, last) as
+             *             part of group, see the templated overload.
+             *
+             * @param[in]  first  Pointer to the first task to add.
+             * @param[in]  last   Pointer to one past the last task to add.
+             * @param[in]  group  The group the tasks belong to, must outlive
+             *                    the tasks.
+             */
+            virtual void addTasks(Task* first, Task* last, TaskGroup& group) override;
+
+            /**
+             * @brief      Removes all the tasks from the taskQueue. The groups
+             *             of the removed tasks are marked as done for them.
              */
             void clearTasks();
 
             /**
-             * @brief      Blocking function, finishes running all the functions in the queue.
+             * @brief      Blocking function, returns when all the tasks in the
+             *             queue have been run. The calling thread helps run
+             *             the queued tasks while waiting.
              */
             void wait();
 
+            /**
+             * @brief      Blocking function, returns when all the tasks in
+             *             group have been run. The calling thread helps run
+             *             queued tasks while waiting, which might include
+             *             tasks from other groups.
+             *
+             * @param[in]  group  The group to wait for.
+             */
+            virtual void wait(const TaskGroup& group) override;
+
             /**
              * @brief      Returns the number of threads this pool has.
              *
              * @return     Number of threads belonging to this pool.
              */
-            std::size_t threadCount() const;
+            virtual std::size_t threadCount() const override;
 
         private:
+            /**
+             * @brief      A task along with the group it belongs to, if any.
+             */
+            struct Job
+            {
+                Task task{};
+                TaskGroup* group{};
+            };
+
+            /**
+             * @brief      Pushes the jobs in the range [first, last) onto the
+             *             queue, and wakes the workers.
+             */
+            template<class Iterator>
+            void pushJobs(Iterator first, Iterator last, TaskGroup* group);
+
+            /**
+             * @brief      Tries to pop a job from the queue and run it.
+             *
+             * @return     True if a job was run, false if the queue was empty.
+             */
+            bool runPending();
+
+            /**
+             * @brief      Runs the job, completing it in its group and in
+             *             taskCount.
+             */
+            void run(Job& job);
+
             std::condition_variable cv{};
             std::mutex cvMutex{};
-            QueueType<Task> tasks;
+            QueueType<Job> tasks;
             std::vector<std::thread> threads{};
 
             /**
@@ -1,8 +1,10 @@
 #include <algorithm>
 #include <chrono>
+#include <iterator>
 
 template<template<class> class QueueType>
-nox::thread::Pool<QueueType>::Pool(std::size_t threadCount)
+nox::thread::Pool<QueueType>::Pool(std::size_t threadCount,
+                                   const std::vector<std::size_t>& cpuAffinity)
     : threads(threadCount)
 {
     auto workerFunc = [this]() -> void
@@ -10,12 +12,12 @@ nox::thread::Pool<QueueType>::Pool(std::size_t threadCount)
         while (this->shouldContinue.load(std::memory_order_relaxed))
         {
             std::unique_lock<std::mutex> lock(this->cvMutex);
-            Task task{};
+            Job job{};
 
-            // Stop waiting if: A task is popped successfully from the queue or we should not continue.
-            auto waitPred = [this, &task]()
+            // Stop waiting if: A job is popped successfully from the queue or we should not continue.
+            auto waitPred = [this, &job]()
             {
-                return this->tasks.pop(task) ||
+                return this->tasks.pop(job) ||
                        !this->shouldContinue.load(std::memory_order_relaxed);
             };
 
@@ -26,21 +28,24 @@ nox::thread::Pool<QueueType>::Pool(std::size_t threadCount)
                               std::chrono::milliseconds(250),
                               [waitPred]() { return waitPred(); });
 
-            // No need to continue waiting after we have gotten the task.
+            // No need to continue waiting after we have gotten the job.
             lock.unlock();
 
             // Task won't be valid if we exit because we are stopping the pool.
-            if (task)
+            if (job.task)
             {
-                task();
-                this->taskCount.fetch_sub(1, std::memory_order_release);
+                this->run(job);
             }
         }
     };
 
-    for (auto& thread : this->threads)
+    for (std::size_t i = 0; i < this->threads.size(); ++i)
     {
-        thread = std::thread(workerFunc);
+        this->threads[i] = std::thread(workerFunc);
+        if (!cpuAffinity.empty())
+        {
+            nox::thread::setThreadAffinity(this->threads[i], cpuAffinity[i % cpuAffinity.size()]);
+        }
     }
 }
 
@@ -48,7 +53,7 @@ template<template<class> class QueueType>
 nox::thread::Pool<QueueType>::~Pool()
 {
     this->shouldContinue.store(false, std::memory_order_relaxed);
-    this->tasks.clear();
+    this->clearTasks();
 
     this->cv.notify_all();
 
@@ -60,20 +65,54 @@ nox::thread::Pool<QueueType>::~Pool()
 
 template<template<class> class QueueType>
 void
-nox::thread::Pool<QueueType>::addTask(const Task& task)
+nox::thread::Pool<QueueType>::addTask(Task task)
+{
+    this->pushJobs(std::make_move_iterator(&task), std::make_move_iterator(&task + 1), nullptr);
+}
+
+template<template<class> class QueueType>
+template<class Iterator>
+void
+nox::thread::Pool<QueueType>::addTasks(Iterator first, Iterator last)
+{
+    this->pushJobs(first, last, nullptr);
+}
+
+template<template<class> class QueueType>
+void
+nox::thread::Pool<QueueType>::addTask(Task task, TaskGroup& group)
+{
+    this->pushJobs(std::make_move_iterator(&task), std::make_move_iterator(&task + 1), &group);
+}
+
+template<template<class> class QueueType>
+template<class Iterator>
+void
+nox::thread::Pool<QueueType>::addTasks(Iterator first, Iterator last, TaskGroup& group)
 {
-    this->tasks.push(task);
-    this->taskCount.fetch_add(1, std::memory_order_release);
+    this->pushJobs(first, last, &group);
+}
 
-    this->cv.notify_one();
+template<template<class> class QueueType>
+void
+nox::thread::Pool<QueueType>::addTasks(Task* first, Task* last, TaskGroup& group)
+{
+    this->pushJobs(std::make_move_iterator(first), std::make_move_iterator(last), &group);
 }
 
 template<template<class> class QueueType>
 void
 nox::thread::Pool<QueueType>::clearTasks()
 {
-    this->tasks.clear();
-    this->taskCount.store(0, std::memory_order_release);
+    Job job{};
+    while (this->tasks.pop(job))
+    {
+        if (job.group)
+        {
+            job.group->done();
+        }
+        this->taskCount.fetch_sub(1, std::memory_order_release);
+    }
 }
 
 template<template<class> class QueueType>
@@ -82,8 +121,24 @@ nox::thread::Pool<QueueType>::wait()
 {
     while (this->taskCount.load(std::memory_order_acquire) != 0)
     {
-        this->cv.notify_all();
-        std::this_thread::yield();
+        // The remaining tasks might already be running on the workers.
+        if (!this->runPending())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+template<template<class> class QueueType>
+void
+nox::thread::Pool<QueueType>::wait(const TaskGroup& group)
+{
+    while (!group.isDone())
+    {
+        if (!this->runPending())
+        {
+            std::this_thread::yield();
+        }
     }
 }
 
@@ -93,3 +148,63 @@ nox::thread::Pool<QueueType>::threadCount() const
 {
     return this->threads.size();
 }
+
+template<template<class> class QueueType>
+template<class Iterator>
+void
+nox::thread::Pool<QueueType>::pushJobs(Iterator first, Iterator last, TaskGroup* group)
+{
+    const auto count = static_cast<std::size_t>(std::distance(first, last));
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Both counts must be raised before any job can be popped and completed.
+    if (group)
+    {
+        group->add(count);
+    }
+    this->taskCount.fetch_add(count, std::memory_order_release);
+
+    for (; first != last; ++first)
+    {
+        this->tasks.push(Job{std::move(*first), group});
+    }
+
+    if (count == 1)
+    {
+        this->cv.notify_one();
+    }
+    else
+    {
+        this->cv.notify_all();
+    }
+}
+
+template<template<class> class QueueType>
+bool
+nox::thread::Pool<QueueType>::runPending()
+{
+    Job job{};
+    if (!this->tasks.pop(job))
+    {
+        return false;
+    }
+
+    this->run(job);
+    return true;
+}
+
+template<template<class> class QueueType>
+void
+nox::thread::Pool<QueueType>::run(Job& job)
+{
+    job.task();
+
+    if (job.group)
+    {
+        job.group->done();
+    }
+    this->taskCount.fetch_sub(1, std::memory_order_release);
+}
@@ -0,0 +1,79 @@
+#ifndef NOX_THREAD_TAGGEDPOINTER_H_
+#define NOX_THREAD_TAGGEDPOINTER_H_
+#include <cstdint>
+
+namespace nox
+{
+    namespace thread
+    {
+        /**
+         * @brief      A pointer and a tag packed into 64 bits, meant to be
+         *             stored in a std::atomic to avoid the ABA problem in
+         *             lock-free linked structures. The tag is incremented on
+         *             every change of the atomic, so a compare exchange fails
+         *             if the pointer has been changed and changed back since
+         *             it was loaded.
+         *
+         * @detail     On 64-bit platforms the pointer takes the lower 48 bits,
+         *             which covers the user space addresses on x86-64 and
+         *             AArch64, and the tag the upper 16 bits. On 32-bit
+         *             platforms both get 32 bits. A stale compare exchange
+         *             can only succeed if a thread is stalled while the tag
+         *             wraps around.
+         *
+         * @tparam     T     The type pointed to.
+         */
+        template<class T>
+        class TaggedPointer
+        {
+        public:
+            /**
+             * @brief      Creates a null pointer with tag 0.
+             */
+            TaggedPointer() = default;
+
+            /**
+             * @brief      Creates a tagged pointer.
+             *
+             * @param      pointer  The pointer to store.
+             * @param[in]  tag      The tag to store, truncated to the number
+             *                      of bits available.
+             */
+            TaggedPointer(T* pointer, std::uint64_t tag);
+
+            /**
+             * @brief      Gets the stored pointer.
+             *
+             * @return     The stored pointer.
+             */
+            T* getPointer() const;
+
+            /**
+             * @brief      Gets the stored tag.
+             *
+             * @return     The stored tag.
+             */
+            std::uint64_t getTag() const;
+
+            /**
+             * @brief      Creates a tagged pointer holding pointer, and the
+             *             tag following the tag of this.
+             *
+             * @param      pointer  The pointer to store.
+             *
+             * @return     The new tagged pointer.
+             */
+            TaggedPointer next(T* pointer) const;
+
+        private:
+            static constexpr std::uint64_t POINTER_BITS = (sizeof(void*) == 8) ? 48 : 32;
+            static constexpr std::uint64_t POINTER_MASK = (std::uint64_t{1} << POINTER_BITS) - 1;
+
+            std::uint64_t value{0};
+        };
+    }
+}
+
+#include <nox/thread/TaggedPointer.tpp>
+
+#endif
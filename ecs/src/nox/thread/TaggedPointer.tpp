@@ -0,0 +1,35 @@
+#include <cstdint>
+
+#include <nox/util/nox_assert.h>
+
+template<class T>
+nox::thread::TaggedPointer<T>::TaggedPointer(T* pointer, std::uint64_t tag)
+    : value((static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(pointer)) & POINTER_MASK) |
+            (tag << POINTER_BITS))
+{
+    NOX_ASSERT((reinterpret_cast<std::uintptr_t>(pointer) & ~POINTER_MASK) == 0,
+               "Pointer %p does not fit within %zu bits!",
+               static_cast<void*>(pointer),
+               static_cast<std::size_t>(POINTER_BITS));
+}
+
+template<class T>
+T*
+nox::thread::TaggedPointer<T>::getPointer() const
+{
+    return reinterpret_cast<T*>(static_cast<std::uintptr_t>(this->value & POINTER_MASK));
+}
+
+template<class T>
+std::uint64_t
+nox::thread::TaggedPointer<T>::getTag() const
+{
+    return this->value >> POINTER_BITS;
+}
+
+template<class T>
+nox::thread::TaggedPointer<T>
+nox::thread::TaggedPointer<T>::next(T* pointer) const
+{
+    return TaggedPointer(pointer, this->getTag() + 1);
+}
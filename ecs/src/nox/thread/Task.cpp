@@ -0,0 +1,74 @@
+#include <nox/thread/Task.h>
+
+#include <cstring>
+
+#include <nox/util/nox_assert.h>
+
+nox::thread::Task::Task(Task&& source) noexcept
+{
+    this->moveFrom(source);
+}
+
+nox::thread::Task&
+nox::thread::Task::operator=(Task&& source) noexcept
+{
+    if (this != &source)
+    {
+        this->reset();
+        this->moveFrom(source);
+    }
+    return *this;
+}
+
+nox::thread::Task::~Task()
+{
+    this->reset();
+}
+
+void
+nox::thread::Task::operator()()
+{
+    NOX_ASSERT(this->invoke, "Calling an empty task!");
+    this->invoke(this->storage);
+}
+
+nox::thread::Task::operator bool() const
+{
+    return this->invoke != nullptr;
+}
+
+void
+nox::thread::Task::reset()
+{
+    if (this->manage)
+    {
+        this->manage(nullptr, this->storage);
+    }
+
+    this->invoke = nullptr;
+    this->manage = nullptr;
+}
+
+void
+nox::thread::Task::moveFrom(Task& source)
+{
+    if (!source.invoke)
+    {
+        return;
+    }
+
+    if (source.manage)
+    {
+        source.manage(this->storage, source.storage);
+    }
+    else
+    {
+        std::memcpy(this->storage, source.storage, STORAGE_SIZE);
+    }
+
+    this->invoke = source.invoke;
+    this->manage = source.manage;
+
+    source.invoke = nullptr;
+    source.manage = nullptr;
+}
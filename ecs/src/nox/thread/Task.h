@@ -0,0 +1,130 @@
+#ifndef NOX_THREAD_TASK_H_
+#define NOX_THREAD_TASK_H_
+#include <cstddef>
+#include <type_traits>
+
+namespace nox
+{
+    namespace thread
+    {
+        /**
+         * @brief      Move-only callable taking no arguments and returning
+         *             nothing, used as the task type of the thread pools.
+         *
+         * @detail     Unlike std::function the callable is always stored
+         *             inline in the task, meaning that creating, moving and
+         *             destroying a task never allocates. Callables that are
+         *             trivially copyable and destructible (i.e. lambdas only
+         *             capturing pointers, references and numbers) are moved
+         *             with a plain memcpy.
+         *
+         *             Callables larger than STORAGE_SIZE are rejected at
+         *             compile time, capture a pointer to the state instead.
+         */
+        class Task
+        {
+        public:
+            /**
+             * @brief      Number of bytes available for the callable.
+             */
+            static constexpr std::size_t STORAGE_SIZE = 48;
+
+            /**
+             * @brief      Creates an empty task, calling it is illegal.
+             */
+            Task() = default;
+
+            /**
+             * @brief      Creates a task holding the given callable.
+             *
+             * @param[in]  function  The callable to store, it is moved or
+             *                       copied into the task.
+             *
+             * @tparam     Function  Must be callable as void(), be nothrow
+             *                       move constructible, and satisfy:
+             *                       sizeof(Function) <= STORAGE_SIZE.
+             */
+            template<class Function,
+                     class = std::enable_if_t<!std::is_same<std::decay_t<Function>, Task>::value>>
+            Task(Function&& function);
+
+            /**
+             * @brief      Tasks are move-only.
+             */
+            Task(const Task&) = delete;
+
+            /**
+             * @brief      Tasks are move-only.
+             */
+            Task& operator=(const Task&) = delete;
+
+            /**
+             * @brief      Move constructor. source is empty after moving.
+             *
+             * @param[in]  source  The task to move from.
+             */
+            Task(Task&& source) noexcept;
+
+            /**
+             * @brief      Move assignment operator. source is empty after
+             *             moving. The class is tolerant of self-assignment.
+             *
+             * @param[in]  source  The task to move from.
+             *
+             * @return     *this after assignment.
+             */
+            Task& operator=(Task&& source) noexcept;
+
+            /**
+             * @brief      Destroys the stored callable.
+             */
+            ~Task();
+
+            /**
+             * @brief      Calls the stored callable. The task must not be
+             *             empty.
+             */
+            void operator()();
+
+            /**
+             * @brief      Checks if the task holds a callable.
+             *
+             * @return     True if the task holds a callable, false otherwise.
+             */
+            explicit operator bool() const;
+
+        private:
+            /**
+             * @brief      Calls the callable stored in storage.
+             */
+            using Invoke = void(*)(void* storage);
+
+            /**
+             * @brief      Move constructs the callable in source into
+             *             destination and destroys the callable in source.
+             *             If destination is nullptr the callable in source is
+             *             only destroyed. nullptr for trivial callables.
+             */
+            using Manage = void(*)(void* destination, void* source);
+
+            /**
+             * @brief      Destroys the held callable and makes the task empty.
+             */
+            void reset();
+
+            /**
+             * @brief      Takes over the callable of source, leaving source
+             *             empty. The task must be empty.
+             */
+            void moveFrom(Task& source);
+
+            alignas(std::max_align_t) unsigned char storage[STORAGE_SIZE];
+            Invoke invoke{};
+            Manage manage{};
+        };
+    }
+}
+
+#include <nox/thread/Task.tpp>
+
+#endif
@@ -0,0 +1,35 @@
+#include <new>
+#include <utility>
+
+template<class Function, class>
+nox::thread::Task::Task(Function&& function)
+{
+    using Callable = std::decay_t<Function>;
+    static_assert(sizeof(Callable) <= STORAGE_SIZE,
+                  "Callable is too large to be stored in a Task, capture a pointer to the state instead");
+    static_assert(alignof(Callable) <= alignof(std::max_align_t),
+                  "Callable is over aligned");
+    static_assert(std::is_nothrow_move_constructible<Callable>::value,
+                  "Callable must be nothrow move constructible");
+
+    new(this->storage) Callable(std::forward<Function>(function));
+
+    this->invoke = [](void* storage)
+    {
+        (*static_cast<Callable*>(storage))();
+    };
+
+    // Trivial callables are moved with a memcpy, and need no destruction.
+    this->manage = (std::is_trivially_copyable<Callable>::value &&
+                    std::is_trivially_destructible<Callable>::value)
+                   ? Manage{nullptr}
+                   : [](void* destination, void* source)
+                     {
+                         auto callable = static_cast<Callable*>(source);
+                         if (destination)
+                         {
+                             new(destination) Callable(std::move(*callable));
+                         }
+                         callable->~Callable();
+                     };
+}
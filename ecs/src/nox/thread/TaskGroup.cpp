@@ -0,0 +1,19 @@
+#include <nox/thread/TaskGroup.h>
+
+void
+nox::thread::TaskGroup::add(std::size_t count)
+{
+    this->pending.fetch_add(count, std::memory_order_relaxed);
+}
+
+void
+nox::thread::TaskGroup::done()
+{
+    this->pending.fetch_sub(1, std::memory_order_release);
+}
+
+bool
+nox::thread::TaskGroup::isDone() const
+{
+    return this->pending.load(std::memory_order_acquire) == 0;
+}
@@ -0,0 +1,86 @@
+#ifndef NOX_THREAD_TASKGROUP_H_
+#define NOX_THREAD_TASKGROUP_H_
+#include <atomic>
+#include <cstddef>
+
+namespace nox
+{
+    namespace thread
+    {
+        /**
+         * @brief      Completion latch for a batch of tasks. Tasks are added
+         *             to a group through the thread pools, and the group is
+         *             done once all of them have been run, allowing callers
+         *             to wait for their own batch rather than for every task
+         *             in the pool.
+         *
+         * @detail     A group can be reused once it is done. It must outlive
+         *             all the tasks added to it.
+         */
+        class TaskGroup
+        {
+        public:
+            /**
+             * @brief      Creates an empty group, which is done.
+             */
+            TaskGroup() = default;
+
+            /**
+             * @brief      As a result of the atomics, the type is non-copy-constructible.
+             */
+            TaskGroup(const TaskGroup&) = delete;
+
+            /**
+             * @brief      As a result of the atomics, the type is non-copy-assignable.
+             */
+            TaskGroup& operator=(const TaskGroup&) = delete;
+
+            /**
+             * @brief      As a result of the atomics, the type is non-move-constructible.
+             */
+            TaskGroup(TaskGroup&&) = delete;
+
+            /**
+             * @brief      As a result of the atomics, the type is non-move-assignable.
+             */
+            TaskGroup& operator=(TaskGroup&&) = delete;
+
+            /**
+             * @brief      Registers count tasks as pending within the group.
+             *             Must be called before the tasks are made available
+             *             to the workers.
+             *
+             * @param[in]  count  The number of tasks to add.
+             */
+            void add(std::size_t count);
+
+            /**
+             * @brief      Marks one pending task as done. The group must not
+             *             be touched by the caller afterwards, as a waiting
+             *             thread might destroy it.
+             */
+            void done();
+
+            /**
+             * @brief      Checks if all tasks added to the group have been
+             *             run.
+             *
+             * @return     True if no tasks are pending, false otherwise.
+             */
+            bool isDone() const;
+
+        private:
+            /**
+             * @brief      Number of tasks added but not yet run.
+             *
+             *             Memory Order: Acquire release, done releases the
+             *             side effects of the task, which isDone acquires, so
+             *             the waiter sees the results of every task in the
+             *             group.
+             */
+            std::atomic<std::size_t> pending{0};
+        };
+    }
+}
+
+#endif
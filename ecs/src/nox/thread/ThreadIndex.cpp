@@ -0,0 +1,53 @@
+#include <nox/thread/ThreadIndex.h>
+
+#include <array>
+#include <atomic>
+
+namespace
+{
+    namespace local
+    {
+        /**
+         * @brief      Whether or not each index is taken by a thread.
+         */
+        std::array<std::atomic<bool>, nox::thread::ThreadIndex::MAX_COUNT> taken{};
+
+        /**
+         * @brief      Claims the first free index on construction, and
+         *             releases it on destruction, i.e. when the thread exits.
+         */
+        struct Slot
+        {
+            Slot()
+            {
+                for (std::size_t i = 0; i < taken.size(); ++i)
+                {
+                    bool expected = false;
+                    if (!taken[i].load(std::memory_order_relaxed) &&
+                        taken[i].compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    {
+                        this->index = i;
+                        break;
+                    }
+                }
+            }
+
+            ~Slot()
+            {
+                if (this->index != nox::thread::ThreadIndex::INVALID)
+                {
+                    taken[this->index].store(false, std::memory_order_release);
+                }
+            }
+
+            std::size_t index{nox::thread::ThreadIndex::INVALID};
+        };
+    }
+}
+
+std::size_t
+nox::thread::ThreadIndex::get()
+{
+    thread_local local::Slot slot{};
+    return slot.index;
+}
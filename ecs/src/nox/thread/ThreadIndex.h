@@ -0,0 +1,45 @@
+#ifndef NOX_THREAD_THREADINDEX_H_
+#define NOX_THREAD_THREADINDEX_H_
+#include <cstddef>
+
+namespace nox
+{
+    namespace thread
+    {
+        /**
+         * @brief      Hands out small dense indices to threads, so per-thread
+         *             data can be stored in plain arrays rather than through
+         *             thread_local, which can't be used for non-static
+         *             members.
+         *
+         * @detail     A thread gets its index the first time it calls get,
+         *             and gives it back when it exits, so at most MAX_COUNT
+         *             threads hold an index at any time. Threads beyond that
+         *             get INVALID, and must take a fallback path.
+         */
+        class ThreadIndex
+        {
+        public:
+            /**
+             * @brief      The maximum number of threads holding an index at
+             *             the same time.
+             */
+            static constexpr std::size_t MAX_COUNT = 64;
+
+            /**
+             * @brief      Returned to threads when all indices are taken.
+             */
+            static constexpr std::size_t INVALID = MAX_COUNT;
+
+            /**
+             * @brief      Gets the index of the calling thread.
+             *
+             * @return     The index of the calling thread, in [0, MAX_COUNT),
+             *             or INVALID if all indices are taken.
+             */
+            static std::size_t get();
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef NOX_THREAD_WORKSTEALINGDEQUE_H_
+#define NOX_THREAD_WORKSTEALINGDEQUE_H_
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace nox
+{
+    namespace thread
+    {
+        /**
+         * @brief      Lock-free work-stealing deque (Chase-Lev). One thread
+         *             owns the deque and pushes and pops at the bottom, while
+         *             any other thread can steal from the top. The owner
+         *             therefore works in LIFO order, keeping its data hot in
+         *             cache, while thieves take the oldest work.
+         *
+         *             The deque grows when full. Old buffers are kept until
+         *             destruction, as a thief might still be reading from
+         *             them.
+         *
+         * @tparam     T     Must be trivially copyable, as thieves may read a
+         *                   slot that they end up not getting. Usually a
+         *                   pointer.
+         *
+         * @see        Lê, Pop, Cohen, Zappa Nardelli: Correct and Efficient
+         *             Work-Stealing for Weak Memory Models. PPoPP 2013.
+         */
+        template<class T>
+        class WorkStealingDeque
+        {
+        public:
+            static_assert(std::is_trivially_copyable<T>::value, "Type T must be trivially copyable");
+
+            /**
+             * @brief      Creates the deque.
+             *
+             * @param[in]  initialCapacity  The initial capacity of the
+             *                              deque. Must be a power of two.
+             */
+            WorkStealingDeque(std::size_t initialCapacity = 256);
+
+            /**
+             * @brief      As a result of the atomics, the type is non-copy-constructible.
+             */
+            WorkStealingDeque(const WorkStealingDeque&) = delete;
+
+            /**
+             * @brief      As a result of the atomics, the type is non-copy-assignable.
+             */
+            WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+            /**
+             * @brief      As a result of the atomics, the type is non-move-constructible.
+             */
+            WorkStealingDeque(WorkStealingDeque&&) = delete;
+
+            /**
+             * @brief      As a result of the atomics, the type is non-move-assignable.
+             */
+            WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+
+            /**
+             * @brief      Destroys the deque and all its buffers.
+             */
+            ~WorkStealingDeque();
+
+            /**
+             * @brief      Pushes the value onto the bottom of the deque.
+             *
+             * @warning    Must only be called by the owner of the deque.
+             *
+             * @param[in]  value  The value to push.
+             */
+            void
+            push(T value);
+
+            /**
+             * @brief      Pops the bottom value of the deque, i.e. the last
+             *             value pushed.
+             *
+             * @warning    Must only be called by the owner of the deque.
+             *
+             * @param[out] value  Where to store the popped value. Left
+             *                    unchanged if nothing could be popped.
+             *
+             * @return     True if a value was popped, false if the deque was
+             *             empty.
+             */
+            bool
+            pop(T& value);
+
+            /**
+             * @brief      Steals the top value of the deque, i.e. the oldest
+             *             value pushed. Can be called concurrently from any
+             *             thread.
+             *
+             * @param[out] value  Where to store the stolen value. Left
+             *                    unchanged if nothing could be stolen.
+             *
+             * @return     True if a value was stolen. False if the deque was
+             *             empty or another thread won the race for the value.
+             */
+            bool
+            steal(T& value);
+
+            /**
+             * @brief      Checks if the deque is empty. The answer might be
+             *             outdated as soon as it is returned.
+             *
+             * @return     True if the deque was empty at the time of the
+             *             call.
+             */
+            bool
+            empty() const;
+
+        private:
+            /**
+             * @brief      Circular buffer holding the values of the deque.
+             */
+            struct Buffer
+            {
+                Buffer(std::size_t capacity);
+                ~Buffer();
+
+                T load(std::int64_t index) const;
+                void store(std::int64_t index, T value);
+
+                const std::size_t capacity;
+                const std::size_t mask;
+                std::atomic<T>* const slots;
+            };
+
+            /**
+             * @brief      Creates a buffer twice the size of the current one,
+             *             holding the values in the range [top, bottom).
+             */
+            Buffer*
+            grow(Buffer* current, std::int64_t top, std::int64_t bottom);
+
+            /**
+             * @brief      Index of the oldest value, only incremented, by
+             *             thieves or by the owner taking the last value.
+             *             Kept on its own cache line, as it is the only
+             *             variable written to by the thieves.
+             */
+            alignas(64) std::atomic<std::int64_t> top{0};
+
+            /**
+             * @brief      Index one past the newest value, only written to by
+             *             the owner.
+             */
+            alignas(64) std::atomic<std::int64_t> bottom{0};
+
+            std::atomic<Buffer*> buffer{};
+
+            /**
+             * @brief      Buffers replaced by grow, only touched by the owner.
+             */
+            std::vector<Buffer*> retired{};
+        };
+    }
+}
+
+#include <nox/thread/WorkStealingDeque.tpp>
+
+#endif
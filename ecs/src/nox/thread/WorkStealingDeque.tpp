@@ -0,0 +1,162 @@
+#include <nox/util/nox_assert.h>
+
+template<class T>
+nox::thread::WorkStealingDeque<T>::Buffer::Buffer(std::size_t capacity)
+    : capacity(capacity)
+    , mask(capacity - 1)
+    , slots(new std::atomic<T>[capacity])
+{
+}
+
+template<class T>
+nox::thread::WorkStealingDeque<T>::Buffer::~Buffer()
+{
+    delete[] this->slots;
+}
+
+template<class T>
+T
+nox::thread::WorkStealingDeque<T>::Buffer::load(std::int64_t index) const
+{
+    return this->slots[std::size_t(index) & this->mask].load(std::memory_order_relaxed);
+}
+
+template<class T>
+void
+nox::thread::WorkStealingDeque<T>::Buffer::store(std::int64_t index, T value)
+{
+    this->slots[std::size_t(index) & this->mask].store(value, std::memory_order_relaxed);
+}
+
+template<class T>
+nox::thread::WorkStealingDeque<T>::WorkStealingDeque(std::size_t initialCapacity)
+    : buffer(new Buffer(initialCapacity))
+{
+    NOX_ASSERT(initialCapacity > 0 && (initialCapacity & (initialCapacity - 1)) == 0,
+               "initialCapacity must be a power of two, was: %zu", initialCapacity);
+}
+
+template<class T>
+nox::thread::WorkStealingDeque<T>::~WorkStealingDeque()
+{
+    delete this->buffer.load(std::memory_order_relaxed);
+    for (auto item : this->retired)
+    {
+        delete item;
+    }
+}
+
+template<class T>
+void
+nox::thread::WorkStealingDeque<T>::push(T value)
+{
+    const auto b = this->bottom.load(std::memory_order_relaxed);
+    const auto t = this->top.load(std::memory_order_acquire);
+    auto current = this->buffer.load(std::memory_order_relaxed);
+
+    if (b - t > std::int64_t(current->capacity) - 1)
+    {
+        current = this->grow(current, t, b);
+    }
+
+    current->store(b, value);
+
+    // Value must be visible before the thieves can see the new bottom.
+    std::atomic_thread_fence(std::memory_order_release);
+    this->bottom.store(b + 1, std::memory_order_relaxed);
+}
+
+template<class T>
+bool
+nox::thread::WorkStealingDeque<T>::pop(T& value)
+{
+    const auto b = this->bottom.load(std::memory_order_relaxed) - 1;
+    const auto current = this->buffer.load(std::memory_order_relaxed);
+    this->bottom.store(b, std::memory_order_relaxed);
+
+    // Reserving the bottom value must be ordered before reading top,
+    // otherwise we could both pop and have it stolen.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = this->top.load(std::memory_order_relaxed);
+
+    if (t > b)
+    {
+        // Empty, restore bottom.
+        this->bottom.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    auto result = current->load(b);
+    if (t == b)
+    {
+        // Last value, race against the thieves for it.
+        const bool won = this->top.compare_exchange_strong(t,
+                                                           t + 1,
+                                                           std::memory_order_seq_cst,
+                                                           std::memory_order_relaxed);
+        this->bottom.store(b + 1, std::memory_order_relaxed);
+        if (!won)
+        {
+            return false;
+        }
+    }
+
+    value = result;
+    return true;
+}
+
+template<class T>
+bool
+nox::thread::WorkStealingDeque<T>::steal(T& value)
+{
+    auto t = this->top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const auto b = this->bottom.load(std::memory_order_acquire);
+
+    if (t >= b)
+    {
+        return false;
+    }
+
+    const auto current = this->buffer.load(std::memory_order_acquire);
+    const auto result = current->load(t);
+
+    if (!this->top.compare_exchange_strong(t,
+                                           t + 1,
+                                           std::memory_order_seq_cst,
+                                           std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    value = result;
+    return true;
+}
+
+template<class T>
+bool
+nox::thread::WorkStealingDeque<T>::empty() const
+{
+    const auto t = this->top.load(std::memory_order_seq_cst);
+    const auto b = this->bottom.load(std::memory_order_seq_cst);
+    return t >= b;
+}
+
+template<class T>
+typename nox::thread::WorkStealingDeque<T>::Buffer*
+nox::thread::WorkStealingDeque<T>::grow(Buffer* current,
+                                        std::int64_t top,
+                                        std::int64_t bottom)
+{
+    auto newBuffer = new Buffer(current->capacity * 2);
+    for (auto i = top; i != bottom; ++i)
+    {
+        newBuffer->store(i, current->load(i));
+    }
+
+    // Thieves might still be reading from the old buffer, so it can't be deleted yet.
+    this->retired.push_back(current);
+    this->buffer.store(newBuffer, std::memory_order_release);
+
+    return newBuffer;
+}
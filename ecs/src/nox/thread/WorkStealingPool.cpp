@@ -0,0 +1,340 @@
+#include <nox/thread/WorkStealingPool.h>
+
+#include <iterator>
+#include <new>
+
+#include <nox/thread/setThreadAffinity.h>
+#include <nox/util/nox_assert.h>
+
+#ifdef _WIN32
+#include <intrin.h>
+#endif
+
+namespace
+{
+    namespace local
+    {
+        /**
+         * @brief      How many times an idle worker looks for tasks before
+         *             parking.
+         */
+        constexpr std::size_t SPIN_COUNT = 2048;
+
+        /**
+         * @brief      How often an idle worker yields while spinning.
+         */
+        constexpr std::size_t YIELD_INTERVAL = 64;
+
+        /**
+         * @brief      The pool the calling thread is a worker in, if any.
+         *             Used to push onto the workers own deque.
+         */
+        thread_local const nox::thread::WorkStealingPool* currentPool = nullptr;
+
+        /**
+         * @brief      The index of the deque owned by the calling thread.
+         */
+        thread_local std::size_t currentIndex = 0;
+
+        /**
+         * @brief      Tells the CPU that we are in a spin loop.
+         */
+        inline void
+        relax()
+        {
+            #if defined(_WIN32)
+                _mm_pause();
+            #elif defined(__i386__) || defined(__x86_64__)
+                __builtin_ia32_pause();
+            #else
+                std::this_thread::yield();
+            #endif
+        }
+    }
+}
+
+nox::thread::WorkStealingPool::WorkStealingPool(std::size_t threadCount,
+                                                 const std::vector<std::size_t>& cpuAffinity)
+    : queues(threadCount + 1)
+    , threads(threadCount)
+{
+    for (auto& queue : this->queues)
+    {
+        queue = std::make_unique<Queue>();
+    }
+
+    for (std::size_t i = 0; i < this->threads.size(); ++i)
+    {
+        this->threads[i] = std::thread([this, i]() { this->work(i); });
+        if (!cpuAffinity.empty())
+        {
+            nox::thread::setThreadAffinity(this->threads[i], cpuAffinity[i % cpuAffinity.size()]);
+        }
+    }
+}
+
+nox::thread::WorkStealingPool::~WorkStealingPool()
+{
+    this->shouldContinue.store(false, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(this->parkMutex);
+        ++this->wakeEpoch;
+    }
+    this->parkCv.notify_all();
+
+    for (auto& thread : this->threads)
+    {
+        thread.join();
+    }
+
+    this->clearTasks();
+}
+
+void
+nox::thread::WorkStealingPool::addTask(Task task)
+{
+    this->pushTasks(std::make_move_iterator(&task), std::make_move_iterator(&task + 1), nullptr);
+}
+
+void
+nox::thread::WorkStealingPool::addTask(Task task, TaskGroup& group)
+{
+    this->pushTasks(std::make_move_iterator(&task), std::make_move_iterator(&task + 1), &group);
+}
+
+void
+nox::thread::WorkStealingPool::addTasks(Task* first, Task* last, TaskGroup& group)
+{
+    this->pushTasks(std::make_move_iterator(first), std::make_move_iterator(last), &group);
+}
+
+void
+nox::thread::WorkStealingPool::clearTasks()
+{
+    for (auto& queue : this->queues)
+    {
+        TaskNode* node = nullptr;
+        while (!queue->empty())
+        {
+            if (queue->steal(node))
+            {
+                if (node->group)
+                {
+                    node->group->done();
+                }
+                this->destroyNode(node);
+                this->taskCount.fetch_sub(1, std::memory_order_release);
+            }
+        }
+    }
+}
+
+void
+nox::thread::WorkStealingPool::wait()
+{
+    // The task calling wait is part of the count, so it would never reach zero.
+    NOX_ASSERT(local::currentPool != this, "Waiting for all tasks from within a task of the same pool!\n");
+
+    while (this->taskCount.load(std::memory_order_acquire) != 0)
+    {
+        // The remaining tasks might already be running on the workers.
+        if (!this->runPending())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void
+nox::thread::WorkStealingPool::wait(const TaskGroup& group)
+{
+    while (!group.isDone())
+    {
+        if (!this->runPending())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+std::size_t
+nox::thread::WorkStealingPool::threadCount() const
+{
+    return this->threads.size();
+}
+
+void
+nox::thread::WorkStealingPool::work(std::size_t index)
+{
+    local::currentPool = this;
+    local::currentIndex = index;
+
+    std::size_t idleCount = 0;
+    while (this->shouldContinue.load(std::memory_order_relaxed))
+    {
+        auto node = this->findTask(index);
+        if (node)
+        {
+            this->run(node);
+            idleCount = 0;
+        }
+        else if (++idleCount < local::SPIN_COUNT)
+        {
+            if (idleCount % local::YIELD_INTERVAL == 0)
+            {
+                std::this_thread::yield();
+            }
+            else
+            {
+                local::relax();
+            }
+        }
+        else
+        {
+            this->park();
+            idleCount = 0;
+        }
+    }
+
+    local::currentPool = nullptr;
+}
+
+nox::thread::WorkStealingPool::TaskNode*
+nox::thread::WorkStealingPool::createNode(Task task, TaskGroup* group)
+{
+    auto memory = this->nodeAllocator.allocate(sizeof(TaskNode));
+    return new (memory) TaskNode{std::move(task), group};
+}
+
+void
+nox::thread::WorkStealingPool::destroyNode(TaskNode* node)
+{
+    node->~TaskNode();
+    this->nodeAllocator.deallocate(node);
+}
+
+nox::thread::WorkStealingPool::Queue&
+nox::thread::WorkStealingPool::acquireQueue(std::unique_lock<std::mutex>& lock)
+{
+    if (local::currentPool == this)
+    {
+        return *this->queues[local::currentIndex];
+    }
+
+    lock = std::unique_lock<std::mutex>(this->submissionMutex);
+    return *this->queues[this->submissionIndex()];
+}
+
+bool
+nox::thread::WorkStealingPool::runPending()
+{
+    // Non-workers only steal, as the owner end of the submission deque is only used for pushing.
+    const auto index = (local::currentPool == this) ? local::currentIndex : this->submissionIndex();
+    auto node = this->findTask(index);
+    if (!node)
+    {
+        return false;
+    }
+
+    this->run(node);
+    return true;
+}
+
+nox::thread::WorkStealingPool::TaskNode*
+nox::thread::WorkStealingPool::findTask(std::size_t index)
+{
+    TaskNode* node = nullptr;
+    if (index < this->submissionIndex() && this->queues[index]->pop(node))
+    {
+        return node;
+    }
+
+    // Start stealing from our neighbour, so the workers don't all hammer the same deque.
+    const auto count = this->queues.size();
+    for (std::size_t i = 1; i <= count; ++i)
+    {
+        const auto victim = (index + i) % count;
+        if (this->queues[victim]->steal(node))
+        {
+            return node;
+        }
+    }
+
+    return nullptr;
+}
+
+void
+nox::thread::WorkStealingPool::run(TaskNode* node)
+{
+    node->task();
+
+    if (node->group)
+    {
+        node->group->done();
+    }
+    this->destroyNode(node);
+    this->taskCount.fetch_sub(1, std::memory_order_release);
+}
+
+void
+nox::thread::WorkStealingPool::park()
+{
+    std::unique_lock<std::mutex> lock(this->parkMutex);
+    const auto epoch = this->wakeEpoch;
+
+    this->sleepingCount.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // A task might have been pushed after our last search, but before we registered as sleeping.
+    if (!this->hasTasks())
+    {
+        this->parkCv.wait(lock,
+                          [this, epoch]()
+                          {
+                              return this->wakeEpoch != epoch ||
+                                     !this->shouldContinue.load(std::memory_order_relaxed);
+                          });
+    }
+
+    this->sleepingCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void
+nox::thread::WorkStealingPool::wakeWorkers(std::size_t count)
+{
+    // Pairs with the fence in park, either we see the sleeper, or the sleeper sees the task.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (this->sleepingCount.load(std::memory_order_seq_cst) == 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->parkMutex);
+        ++this->wakeEpoch;
+    }
+
+    if (count == 1)
+    {
+        this->parkCv.notify_one();
+    }
+    else
+    {
+        this->parkCv.notify_all();
+    }
+}
+
+bool
+nox::thread::WorkStealingPool::hasTasks() const
+{
+    return std::any_of(std::cbegin(this->queues),
+                       std::cend(this->queues),
+                       [](const auto& queue) { return !queue->empty(); });
+}
+
+std::size_t
+nox::thread::WorkStealingPool::submissionIndex() const
+{
+    return this->queues.size() - 1;
+}
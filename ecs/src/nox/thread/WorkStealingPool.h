@@ -0,0 +1,356 @@
+#ifndef NOX_THREAD_WORKSTEALINGPOOL_H_
+#define NOX_THREAD_WORKSTEALINGPOOL_H_
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <nox/memory/PoolAllocator.h>
+#include <nox/thread/Executor.h>
+#include <nox/thread/Task.h>
+#include <nox/thread/TaskGroup.h>
+#include <nox/thread/WorkStealingDeque.h>
+
+namespace nox
+{
+    namespace thread
+    {
+        /**
+         * @brief      Work-stealing thread pool, offering the same interface
+         *             as nox::thread::Pool, and can be used as a drop-in
+         *             replacement.
+         *
+         * @detail     Every worker owns a WorkStealingDeque. Tasks added from
+         *             a worker go onto its own deque, while tasks added from
+         *             any other thread go onto a shared submission deque.
+         *             Workers first pop from their own deque, and then steal
+         *             from the others, meaning that acquiring a task never
+         *             takes a lock.
+         *
+         *             Idle workers spin for a while looking for tasks, before
+         *             parking on a condition variable. Adding a task only
+         *             touches the condition variable if a worker is parked.
+         *
+         * @see        nox::thread::Pool
+         */
+        class WorkStealingPool
+            : public nox::thread::Executor
+        {
+        public:
+            /**
+             * @brief      Same task type as nox::thread::Pool.
+             */
+            using Task = nox::thread::Task;
+
+            /**
+             * @brief      Creates a pool with the given number of threads. If
+             *             no parameters are given, the pool asks the OS how
+             *             many threads are available and creates that amount,
+             *             minimum one.
+             *
+             *             If cpuAffinity is given, thread i is pinned to CPU
+             *             cpuAffinity[i % cpuAffinity.size()]. Pinning is best
+             *             effort, and ignored where it is unsupported.
+             *
+             * @param[in]  threadCount  The number of threads in the pool.
+             * @param[in]  cpuAffinity  The CPUs to pin the threads to, empty
+             *                          leaves the threads unpinned.
+             */
+            WorkStealingPool(std::size_t threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1u,
+                             const std::vector<std::size_t>& cpuAffinity = {});
+
+            /**
+             * @brief      Copy constructing thread pool is illegal because of the
+             *             non-copyable types.
+             */
+            WorkStealingPool(const WorkStealingPool&) = delete;
+
+            /**
+             * @brief      Copy assigning thread pool is illegal because of the
+             *             non-copyable types.
+             */
+            WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+            /**
+             * @brief      Move constructing thread pool is illegal because of the
+             *             non-movable types.
+             */
+            WorkStealingPool(WorkStealingPool&&) = delete;
+
+            /**
+             * @brief      Move assigning thread pool is illegal because of the
+             *             non-movable types.
+             */
+            WorkStealingPool& operator=(WorkStealingPool&&) = delete;
+
+            /**
+             * @brief      Notifies all threads that they should stop execution,
+             *             before joining the threads. All tasks left in the
+             *             deques are discarded.
+             */
+            virtual ~WorkStealingPool() override;
+
+            /**
+             * @brief      Adds a task to be run by the pool.
+             *
+             * @param[in]  task  The task to run.
+             */
+            void addTask(Task task);
+
+            /**
+             * @brief      Adds all the tasks in the range [first, last) to be
+             *             run by the pool. The deque is only locked once, and
+             *             parked workers are only woken once for the whole
+             *             batch.
+             *
+             * @param[in]  first     Iterator to the first task to add.
+             * @param[in]  last      Iterator to one past the last task to add.
+             *
+             * @tparam     Iterator  Forward iterator to Task, the tasks are
+             *                       moved from.
+             */
+            template<class Iterator>
+            void addTasks(Iterator first, Iterator last);
+
+            /**
+             * @brief      Adds a task to be run by the pool, as part of group.
+             *
+             * @param[in]  task   The task to run.
+             * @param[in]  group  The group the task belongs to, must outlive
+             *                    the task.
+             */
+            virtual void addTask(Task task, TaskGroup& group) override;
+
+            /**
+             * @brief      Adds all the tasks in the range [first, last) to be
+             *             run by the pool, as part of group.
+             *
+             * @param[in]  first     Iterator to the first task to add.
+             * @param[in]  last      Iterator to one past the last task to add.
+             * @param[in]  group     The group the tasks belong to, must
+             *                       outlive the tasks.
+             *
+             * @tparam     Iterator  Forward iterator to Task, the tasks are
+             *                       moved from.
+             */
+            template<class Iterator>
+            void addTasks(Iterator first, Iterator last, TaskGroup& group);
+
+            /**
+             * @brief      Adds all the tasks in the range [first, last) as
+             *             part of group, see the templated overload.
+             *
+             * @param[in]  first  Pointer to the first task to add.
+             * @param[in]  last   Pointer to one past the last task to add.
+             * @param[in]  group  The group the tasks belong to, must outlive
+             *                    the tasks.
+             */
+            virtual void addTasks(Task* first, Task* last, TaskGroup& group) override;
+
+            /**
+             * @brief      Removes all the tasks that have not been started yet.
+             *             The groups of the removed tasks are marked as done
+             *             for them.
+             */
+            void clearTasks();
+
+            /**
+             * @brief      Blocking function, returns when all the tasks added
+             *             have been run. The calling thread helps run tasks
+             *             while waiting.
+             *
+             * @warning    Must not be called from within a task run by this
+             *             pool, as the calling task would be waiting for
+             *             itself. Use wait(const TaskGroup&) there instead.
+             */
+            void wait();
+
+            /**
+             * @brief      Blocking function, returns when all the tasks in
+             *             group have been run. The calling thread helps run
+             *             tasks while waiting, which might include tasks from
+             *             other groups. Can be called from within a task.
+             *
+             * @param[in]  group  The group to wait for.
+             */
+            virtual void wait(const TaskGroup& group) override;
+
+            /**
+             * @brief      Returns the number of threads this pool has.
+             *
+             * @return     Number of threads belonging to this pool.
+             */
+            virtual std::size_t threadCount() const override;
+
+        private:
+            /**
+             * @brief      Tasks are stored through pointers, as the deques
+             *             only support trivially copyable types.
+             */
+            struct TaskNode
+            {
+                Task task;
+                TaskGroup* group;
+            };
+
+            using Queue = WorkStealingDeque<TaskNode*>;
+
+            /**
+             * @brief      Task nodes are allocated on the submitting thread,
+             *             and freed on the thread running them.
+             */
+            using NodeAllocator = nox::memory::PoolAllocator<sizeof(TaskNode)>;
+
+            /**
+             * @brief      Allocates and constructs a task node.
+             */
+            TaskNode* createNode(Task task, TaskGroup* group);
+
+            /**
+             * @brief      Destroys and deallocates a task node.
+             */
+            void destroyNode(TaskNode* node);
+
+            /**
+             * @brief      Returns the deque the calling thread should push
+             *             onto. Workers get their own deque, any other thread
+             *             gets the shared submission deque, in which case lock
+             *             is locked on submissionMutex.
+             *
+             * @param[out] lock  Locked if the submission deque is returned,
+             *                   otherwise left unchanged.
+             *
+             * @return     The deque to push onto.
+             */
+            Queue& acquireQueue(std::unique_lock<std::mutex>& lock);
+
+            /**
+             * @brief      Pushes the tasks in the range [first, last) onto the
+             *             deque of the calling thread, and wakes the workers.
+             */
+            template<class Iterator>
+            void pushTasks(Iterator first, Iterator last, TaskGroup* group);
+
+            /**
+             * @brief      Finds a task and runs it on the calling thread,
+             *             whether or not it is a worker.
+             *
+             * @return     True if a task was run, false if none was found.
+             */
+            bool runPending();
+
+            /**
+             * @brief      The loop run by each of the workers.
+             *
+             * @param[in]  index  The index of the deque owned by the worker.
+             */
+            void work(std::size_t index);
+
+            /**
+             * @brief      Looks for a task, first in the deque at index, then
+             *             by stealing from the other deques.
+             *
+             * @param[in]  index  The index of the deque owned by the caller.
+             *
+             * @return     The task found, nullptr if none could be found.
+             */
+            TaskNode* findTask(std::size_t index);
+
+            /**
+             * @brief      Runs the task, completes it in its group and
+             *             destroys the node.
+             */
+            void run(TaskNode* node);
+
+            /**
+             * @brief      Parks the calling worker until it is woken up by
+             *             wakeWorkers or the pool is stopping. Returns
+             *             immediately if any tasks are available.
+             */
+            void park();
+
+            /**
+             * @brief      Wakes parked workers, if there are any.
+             *
+             * @param[in]  count  How many tasks were just added.
+             */
+            void wakeWorkers(std::size_t count);
+
+            /**
+             * @brief      Checks if any of the deques holds tasks.
+             */
+            bool hasTasks() const;
+
+            /**
+             * @brief      Index of the shared submission deque within queues.
+             */
+            std::size_t submissionIndex() const;
+
+            /**
+             * @brief      One deque per worker, followed by the shared
+             *             submission deque. Allocated separately to avoid
+             *             false sharing between the deques.
+             */
+            std::vector<std::unique_ptr<Queue>> queues{};
+
+            NodeAllocator nodeAllocator{};
+
+            /**
+             * @brief      Guards the owner end of the submission deque, as
+             *             several non-worker threads may add tasks. Thieves
+             *             never take this lock.
+             */
+            std::mutex submissionMutex{};
+
+            std::mutex parkMutex{};
+            std::condition_variable parkCv{};
+
+            /**
+             * @brief      Incremented each time parked workers are woken,
+             *             guarded by parkMutex.
+             */
+            std::size_t wakeEpoch{};
+
+            /**
+             * @brief      Number of workers that are parked, or about to
+             *             park.
+             *
+             *             Memory Order: Sequentially consistent, it is read
+             *             after a task is pushed, and written before a worker
+             *             checks the deques for the last time before parking.
+             *             Either the worker sees the task, or the pusher sees
+             *             the worker.
+             */
+            std::atomic<std::size_t> sleepingCount{0};
+
+            /**
+             * @brief      Indicates how many tasks are left to processed, used
+             *             within the wait function to block the calling thread
+             *             properly.
+             *
+             *             Memory Order: Acquire release, same reasoning as in
+             *             nox::thread::Pool.
+             */
+            std::atomic<std::size_t> taskCount{0};
+
+            /**
+             * @brief      Used to indicate whether or not a thread should
+             *             continue with tasks, or if the pool is stopping.
+             *
+             *             Memory Order: All ordering is relaxed, we are not
+             *             guarding any information with this variable, and it
+             *             is only used for signaling to stop in the future.
+             */
+            std::atomic<bool> shouldContinue{true};
+
+            std::vector<std::thread> threads{};
+        };
+    }
+}
+
+#include <nox/thread/WorkStealingPool.tpp>
+
+#endif
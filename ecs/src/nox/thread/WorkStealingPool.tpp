@@ -0,0 +1,44 @@
+#include <iterator>
+
+template<class Iterator>
+void
+nox::thread::WorkStealingPool::addTasks(Iterator first, Iterator last)
+{
+    this->pushTasks(first, last, nullptr);
+}
+
+template<class Iterator>
+void
+nox::thread::WorkStealingPool::addTasks(Iterator first, Iterator last, TaskGroup& group)
+{
+    this->pushTasks(first, last, &group);
+}
+
+template<class Iterator>
+void
+nox::thread::WorkStealingPool::pushTasks(Iterator first, Iterator last, TaskGroup* group)
+{
+    const auto count = static_cast<std::size_t>(std::distance(first, last));
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Both counts must be raised before any task can be stolen and completed.
+    if (group)
+    {
+        group->add(count);
+    }
+    this->taskCount.fetch_add(count, std::memory_order_release);
+
+    {
+        std::unique_lock<std::mutex> lock{};
+        auto& queue = this->acquireQueue(lock);
+        for (; first != last; ++first)
+        {
+            queue.push(this->createNode(std::move(*first), group));
+        }
+    }
+
+    this->wakeWorkers(count);
+}
@@ -0,0 +1,66 @@
+#ifndef NOX_THREAD_PARALLELFOR_H_
+#define NOX_THREAD_PARALLELFOR_H_
+#include <cstddef>
+
+#include <nox/thread/TaskGroup.h>
+
+namespace nox
+{
+    namespace thread
+    {
+        /**
+         * @brief      Calls function(i) for every i in [begin, end), spread
+         *             over the threads of pool and the calling thread.
+         *             Returns when all the calls are done.
+         *
+         * @detail     The range is split in half recursively, one half being
+         *             added as a task while the other half is split further,
+         *             until the ranges are no larger than grain. The calling
+         *             thread takes part in the work and helps run tasks while
+         *             waiting, so parallelFor can be nested, or called from
+         *             within tasks of the same pool, without adding threads.
+         *
+         * @param      pool      The pool to spread the work over.
+         * @param[in]  begin     The first index.
+         * @param[in]  end       One past the last index.
+         * @param[in]  grain     Largest number of indices run as one task. If
+         *                       0, the grain is chosen based on the number of
+         *                       threads in pool.
+         * @param[in]  function  Called as function(std::size_t), must be safe
+         *                       to call concurrently for different indices.
+         *
+         * @tparam     Pool      nox::thread::Pool or
+         *                       nox::thread::WorkStealingPool.
+         */
+        template<class Pool, class Function>
+        void
+        parallelFor(Pool& pool,
+                    std::size_t begin,
+                    std::size_t end,
+                    std::size_t grain,
+                    const Function& function);
+
+        /**
+         * @brief      Calls all the functions concurrently, spread over the
+         *             threads of pool and the calling thread. Returns when
+         *             all the calls are done. Like parallelFor, the calling
+         *             thread helps run tasks while waiting.
+         *
+         * @param      pool       The pool to spread the work over.
+         * @param[in]  function   Called on the calling thread.
+         * @param[in]  functions  Each added as a task to pool.
+         *
+         * @tparam     Pool       nox::thread::Pool or
+         *                        nox::thread::WorkStealingPool.
+         */
+        template<class Pool, class Function, class... Functions>
+        void
+        parallelInvoke(Pool& pool,
+                       Function&& function,
+                       Functions&&... functions);
+    }
+}
+
+#include <nox/thread/parallelFor.tpp>
+
+#endif
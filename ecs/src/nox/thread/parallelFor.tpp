@@ -0,0 +1,100 @@
+#include <algorithm>
+
+namespace nox
+{
+    namespace thread
+    {
+        /**
+         * @brief      Namespace created to avoid polluting the thread
+         *             namespace with the helpers of parallelFor.
+         */
+        namespace parallel_for_detail
+        {
+            /**
+             * @brief      How many tasks each thread should get when the grain
+             *             is chosen automatically. More than one, so threads
+             *             finishing early can steal from the slower ones.
+             */
+            constexpr std::size_t PARALLEL_FOR_TASKS_PER_THREAD = 4;
+
+            /**
+             * @brief      State shared by all the tasks of one parallelFor
+             *             call, lives on the stack of the caller.
+             */
+            template<class Pool, class Function>
+            struct ParallelForContext
+            {
+                Pool& pool;
+                const Function& function;
+                std::size_t grain;
+                TaskGroup group;
+            };
+
+            /**
+             * @brief      Runs the indices in [begin, end), adding the upper
+             *             halves as tasks while the range is larger than the
+             *             grain.
+             */
+            template<class Pool, class Function>
+            void
+            parallelForSplit(ParallelForContext<Pool, Function>& context,
+                             std::size_t begin,
+                             std::size_t end)
+            {
+                // Hand off the upper half until our own part is small enough.
+                while (end - begin > context.grain)
+                {
+                    const auto middle = begin + (end - begin) / 2;
+                    context.pool.addTask([&context, middle, end]()
+                                         { parallelForSplit(context, middle, end); },
+                                         context.group);
+                    end = middle;
+                }
+
+                for (auto i = begin; i < end; ++i)
+                {
+                    context.function(i);
+                }
+            }
+        }
+    }
+}
+
+template<class Pool, class Function>
+void
+nox::thread::parallelFor(Pool& pool,
+                         std::size_t begin,
+                         std::size_t end,
+                         std::size_t grain,
+                         const Function& function)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+
+    if (grain == 0)
+    {
+        const auto taskCount = (pool.threadCount() + 1) * parallel_for_detail::PARALLEL_FOR_TASKS_PER_THREAD;
+        grain = std::max<std::size_t>((end - begin) / taskCount, 1);
+    }
+
+    parallel_for_detail::ParallelForContext<Pool, Function> context{pool, function, grain, {}};
+    parallel_for_detail::parallelForSplit(context, begin, end);
+    pool.wait(context.group);
+}
+
+template<class Pool, class Function, class... Functions>
+void
+nox::thread::parallelInvoke(Pool& pool,
+                            Function&& function,
+                            Functions&&... functions)
+{
+    TaskGroup group{};
+
+    using Expander = int[];
+    (void)Expander{0, (pool.addTask([&functions]() { functions(); }, group), 0)...};
+
+    function();
+    pool.wait(group);
+}
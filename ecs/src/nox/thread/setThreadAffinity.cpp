@@ -0,0 +1,35 @@
+#include <nox/thread/setThreadAffinity.h>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+bool
+nox::thread::setThreadAffinity(std::thread& thread, std::size_t cpu)
+{
+    #if defined(__linux__)
+        if (cpu >= CPU_SETSIZE)
+        {
+            return false;
+        }
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+    #elif defined(_WIN32)
+        if (cpu >= sizeof(DWORD_PTR) * 8)
+        {
+            return false;
+        }
+
+        return SetThreadAffinityMask(thread.native_handle(), DWORD_PTR{1} << cpu) != 0;
+    #else
+        (void)thread;
+        (void)cpu;
+        return false;
+    #endif
+}
@@ -0,0 +1,24 @@
+#ifndef NOX_THREAD_SETTHREADAFFINITY_H_
+#define NOX_THREAD_SETTHREADAFFINITY_H_
+#include <cstddef>
+#include <thread>
+
+namespace nox
+{
+    namespace thread
+    {
+        /**
+         * @brief      Pins thread to the given CPU. Only supported on Linux
+         *             and Windows, elsewhere the call has no effect.
+         *
+         * @param      thread  The thread to pin, must be joinable.
+         * @param[in]  cpu     The index of the CPU to pin the thread to.
+         *
+         * @return     True if the thread was pinned, false otherwise.
+         */
+        bool
+        setThreadAffinity(std::thread& thread, std::size_t cpu);
+    }
+}
+
+#endif
@@ -0,0 +1,337 @@
+#include <console_application.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <cmd/parser.h>
+#include <nox/memory/PoolAllocator.h>
+#include <nox/thread/BoundedQueue.h>
+#include <nox/thread/LockFreeStack.h>
+
+namespace
+{
+    namespace local
+    {
+        /**
+         * @brief      Number of values each producer pushes per run.
+         */
+        constexpr std::size_t VALUE_COUNT = 100000;
+
+        /**
+         * @brief      Kept small so the queue is full most of the time.
+         */
+        constexpr std::size_t QUEUE_CAPACITY = 64;
+
+        constexpr std::size_t BLOCK_SIZE = 48;
+        constexpr std::size_t BLOCK_WORDS = BLOCK_SIZE / sizeof(std::uint64_t);
+
+        constexpr std::size_t DEFAULT_THREAD_COUNT = 4;
+
+        std::uint64_t
+        makeValue(std::size_t producer, std::size_t index)
+        {
+            return (static_cast<std::uint64_t>(producer) << 32) | index;
+        }
+
+        std::size_t
+        getProducer(std::uint64_t value)
+        {
+            return static_cast<std::size_t>(value >> 32);
+        }
+
+        std::size_t
+        getIndex(std::uint64_t value)
+        {
+            return static_cast<std::size_t>(value & 0xFFFFFFFF);
+        }
+
+        template<class Function>
+        void
+        runThreads(std::size_t count, const Function& function)
+        {
+            std::vector<std::thread> threads;
+            threads.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                threads.emplace_back(function, i);
+            }
+
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        /**
+         * @brief      Checks that results holds every value of producerCount
+         *             producers exactly once.
+         */
+        bool
+        containsEachOnce(const std::vector<std::vector<std::uint64_t>>& results,
+                         std::size_t producerCount)
+        {
+            std::vector<std::uint64_t> values;
+            for (const auto& result : results)
+            {
+                values.insert(std::end(values), std::begin(result), std::end(result));
+            }
+
+            if (values.size() != producerCount * VALUE_COUNT)
+            {
+                return false;
+            }
+
+            std::sort(std::begin(values), std::end(values));
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                if (values[i] != makeValue(i / VALUE_COUNT, i % VALUE_COUNT))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+}
+
+ConsoleApplication::ConsoleApplication()
+    : Application("lock_free_stress", "PTPERF")
+{
+}
+
+bool 
+ConsoleApplication::onInit()
+{
+    log = createLogger();
+    log.setName("ConsoleApplication");
+
+    const auto threadAmount = cmd::g_cmdParser.getIntArgument(cmd::constants::thread_amount_cmd,
+                                                              local::DEFAULT_THREAD_COUNT);
+    this->threadCount = std::max(static_cast<std::size_t>(threadAmount), std::size_t(2));
+
+    const auto runCount = static_cast<std::size_t>(cmd::g_cmdParser.getIntArgument(cmd::constants::run_count_cmd,
+                                                                                   cmd::constants::run_count_default));
+
+    for (std::size_t i = 0; i < runCount; ++i)
+    {
+        log.info().format("Run %zu of %zu with %zu producers and %zu consumers", i + 1, runCount, this->threadCount, this->threadCount);
+
+        if (!this->runStackScenario() ||
+            !this->runStackRecyclingScenario() ||
+            !this->runQueueScenario() ||
+            !this->runPoolScenario())
+        {
+            return false;
+        }
+    }
+
+    log.info().raw("All scenarios passed");
+    return true;
+}
+
+void 
+ConsoleApplication::onUpdate(const nox::Duration& /*deltaTime*/)
+{
+    quitApplication();
+}
+
+bool
+ConsoleApplication::runStackScenario()
+{
+    nox::thread::LockFreeStack<std::uint64_t> stack;
+    std::vector<std::vector<std::uint64_t>> results(this->threadCount);
+    std::atomic<std::size_t> popCount{0};
+    const auto total = this->threadCount * local::VALUE_COUNT;
+
+    local::runThreads(this->threadCount * 2,
+                      [&](std::size_t thread)
+                      {
+                          if (thread < this->threadCount)
+                          {
+                              for (std::size_t i = 0; i < local::VALUE_COUNT; ++i)
+                              {
+                                  stack.push(local::makeValue(thread, i));
+                              }
+                              return;
+                          }
+
+                          auto& result = results[thread - this->threadCount];
+                          std::uint64_t value = 0;
+                          while (popCount.load(std::memory_order_relaxed) < total)
+                          {
+                              if (stack.pop(value))
+                              {
+                                  result.push_back(value);
+                                  popCount.fetch_add(1, std::memory_order_relaxed);
+                              }
+                              else
+                              {
+                                  std::this_thread::yield();
+                              }
+                          }
+                      });
+
+    if (!local::containsEachOnce(results, this->threadCount))
+    {
+        log.error().raw("LockFreeStack lost or duplicated values");
+        return false;
+    }
+
+    return true;
+}
+
+bool
+ConsoleApplication::runStackRecyclingScenario()
+{
+    nox::thread::LockFreeStack<std::uint64_t> stack;
+    std::vector<std::vector<std::uint64_t>> results(this->threadCount);
+    std::atomic<bool> failed{false};
+
+    // Every pop follows a push by the same thread, so the stack is never empty when popping.
+    local::runThreads(this->threadCount,
+                      [&](std::size_t thread)
+                      {
+                          auto& result = results[thread];
+                          std::uint64_t value = 0;
+                          for (std::size_t i = 0; i < local::VALUE_COUNT; ++i)
+                          {
+                              stack.push(local::makeValue(thread, i));
+                              if (!stack.pop(value))
+                              {
+                                  failed.store(true, std::memory_order_relaxed);
+                                  return;
+                              }
+                              result.push_back(value);
+                          }
+                      });
+
+    std::uint64_t value = 0;
+    if (failed.load() || stack.pop(value) || !local::containsEachOnce(results, this->threadCount))
+    {
+        log.error().raw("LockFreeStack lost or duplicated values while recycling nodes");
+        return false;
+    }
+
+    return true;
+}
+
+bool
+ConsoleApplication::runQueueScenario()
+{
+    nox::thread::BoundedQueue<std::uint64_t> queue(local::QUEUE_CAPACITY);
+    std::vector<std::vector<std::uint64_t>> results(this->threadCount);
+    std::atomic<std::size_t> popCount{0};
+    const auto total = this->threadCount * local::VALUE_COUNT;
+
+    local::runThreads(this->threadCount * 2,
+                      [&](std::size_t thread)
+                      {
+                          if (thread < this->threadCount)
+                          {
+                              for (std::size_t i = 0; i < local::VALUE_COUNT; ++i)
+                              {
+                                  queue.push(local::makeValue(thread, i));
+                              }
+                              return;
+                          }
+
+                          auto& result = results[thread - this->threadCount];
+                          std::uint64_t value = 0;
+                          while (popCount.load(std::memory_order_relaxed) < total)
+                          {
+                              if (queue.pop(value))
+                              {
+                                  result.push_back(value);
+                                  popCount.fetch_add(1, std::memory_order_relaxed);
+                              }
+                              else
+                              {
+                                  std::this_thread::yield();
+                              }
+                          }
+                      });
+
+    for (const auto& result : results)
+    {
+        std::vector<std::size_t> next(this->threadCount, 0);
+        for (const auto value : result)
+        {
+            auto& expected = next[local::getProducer(value)];
+            if (local::getIndex(value) < expected)
+            {
+                log.error().raw("BoundedQueue handed out the values of a producer out of order");
+                return false;
+            }
+            expected = local::getIndex(value) + 1;
+        }
+    }
+
+    if (!local::containsEachOnce(results, this->threadCount))
+    {
+        log.error().raw("BoundedQueue lost or duplicated values");
+        return false;
+    }
+
+    return true;
+}
+
+bool
+ConsoleApplication::runPoolScenario()
+{
+    nox::memory::PoolAllocator<local::BLOCK_SIZE> allocator;
+    nox::thread::BoundedQueue<void*> queue(local::QUEUE_CAPACITY);
+    std::vector<std::vector<std::uint64_t>> results(this->threadCount);
+    std::atomic<std::size_t> popCount{0};
+    std::atomic<bool> failed{false};
+    const auto total = this->threadCount * local::VALUE_COUNT;
+
+    // A block handed out twice gets stamped by two producers, which the consumer sees.
+    local::runThreads(this->threadCount * 2,
+                      [&](std::size_t thread)
+                      {
+                          if (thread < this->threadCount)
+                          {
+                              for (std::size_t i = 0; i < local::VALUE_COUNT; ++i)
+                              {
+                                  auto block = static_cast<std::uint64_t*>(allocator.allocate(local::BLOCK_SIZE));
+                                  std::fill(block, block + local::BLOCK_WORDS, local::makeValue(thread, i));
+                                  queue.push(block);
+                              }
+                              return;
+                          }
+
+                          auto& result = results[thread - this->threadCount];
+                          void* memory = nullptr;
+                          while (popCount.load(std::memory_order_relaxed) < total)
+                          {
+                              if (queue.pop(memory))
+                              {
+                                  const auto block = static_cast<std::uint64_t*>(memory);
+                                  const auto stampCount = std::count(block, block + local::BLOCK_WORDS, block[0]);
+                                  if (static_cast<std::size_t>(stampCount) != local::BLOCK_WORDS)
+                                  {
+                                      failed.store(true, std::memory_order_relaxed);
+                                  }
+                                  result.push_back(block[0]);
+                                  allocator.deallocate(memory);
+                                  popCount.fetch_add(1, std::memory_order_relaxed);
+                              }
+                              else
+                              {
+                                  std::this_thread::yield();
+                              }
+                          }
+                      });
+
+    if (failed.load() || !local::containsEachOnce(results, this->threadCount))
+    {
+        log.error().raw("PoolAllocator handed out a block that was already in use");
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+
+#include <nox/app/Application.h>
+#include <nox/log/Logger.h>
+
+/**
+ * @brief      Hammers the lock-free containers and the pool allocator from
+ *             several producer and consumer threads, checking that every
+ *             value comes out exactly once.
+ */
+class ConsoleApplication 
+    : public nox::app::Application
+{
+public:
+    ConsoleApplication();
+
+    virtual bool onInit() override;
+    virtual void onUpdate(const nox::Duration& deltaTime) override;
+
+private:
+    /**
+     * @brief      Producers push onto a LockFreeStack while consumers pop.
+     */
+    bool runStackScenario();
+
+    /**
+     * @brief      Every thread pushes and immediately pops, so the nodes at
+     *             the head are constantly recycled through the pool, which
+     *             is where an unprotected head would suffer from ABA.
+     */
+    bool runStackRecyclingScenario();
+
+    /**
+     * @brief      Producers push into a small BoundedQueue while consumers
+     *             pop, so the ring buffer is full and wraps around
+     *             constantly. Also checks that each consumer sees the
+     *             values of one producer in the order they were pushed.
+     */
+    bool runQueueScenario();
+
+    /**
+     * @brief      Producers allocate and stamp blocks from a PoolAllocator,
+     *             which consumers check and deallocate, so blocks are freed
+     *             on another thread than they were allocated on.
+     */
+    bool runPoolScenario();
+
+    nox::log::Logger log;
+    std::size_t threadCount{0};
+};
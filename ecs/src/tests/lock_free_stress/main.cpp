@@ -0,0 +1,25 @@
+#include <console_application.h>
+#include <cmd/parser.h>
+#include <nox/util/cycle_count.h>
+
+int main(int argc, char* argv[])
+{
+    ConsoleApplication application;
+
+    cmd::g_cmdParser.init(argc, argv);
+    cmd::g_cmdParser.setLogger(application.createLogger());
+    
+    if (application.init(argc, argv) == false)
+    {
+        return 1;
+    }
+
+    auto result = application.execute();
+
+    application.shutdown();
+    
+    const auto cycleCount = nox::util::getCpuCycleCount();
+    printf("Cyclecount: %lu\n", cycleCount);
+
+    return result;
+}
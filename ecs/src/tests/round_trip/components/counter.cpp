@@ -0,0 +1,36 @@
+#include <components/counter.h>
+
+#include <nox/ecs/createEventArgument.h>
+#include <nox/ecs/EntityManager.h>
+
+#include <json/value.h>
+
+constexpr std::size_t components::Counter::EVENT_TYPE;
+constexpr std::size_t components::Counter::AMOUNT_ARGUMENT;
+
+void
+components::Counter::initialize(const Json::Value& value)
+{
+    this->value = value.get("value", 0).asInt64();
+}
+
+void
+components::Counter::update(const nox::Duration& /*deltaTime*/)
+{
+    ++this->updateCount;
+    if (this->updateCount % 4 == 0)
+    {
+        auto event = this->entityManager->createEntityEvent(EVENT_TYPE, this->id, this->id);
+        nox::ecs::createEventArgument(event, static_cast<std::int64_t>(this->updateCount), AMOUNT_ARGUMENT);
+        this->entityManager->sendEntityEvent(std::move(event));
+    }
+}
+
+void
+components::Counter::receiveEntityEvent(const nox::ecs::Event& event)
+{
+    if (event.getType().getValue() == EVENT_TYPE && event.getReceiver() == this->id)
+    {
+        this->value += event.getArgument(AMOUNT_ARGUMENT).value<std::int64_t>();
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+
+#include <nox/ecs/Component.h>
+#include <nox/ecs/EntityId.h>
+#include <nox/ecs/Event.h>
+
+namespace components
+{
+    /**
+     * @brief      Counts its updates, and every few updates sends itself an
+     *             event adding to its value, so both update and the entity
+     *             events leave a trace in the state. Trivially copyable, so
+     *             it is snapshot as raw bytes.
+     */
+    class Counter
+        : public nox::ecs::Component
+    {
+    public:
+        using nox::ecs::Component::Component;
+
+        static constexpr std::size_t EVENT_TYPE = 1000;
+        static constexpr std::size_t AMOUNT_ARGUMENT = 1000;
+
+        void initialize(const Json::Value& value);
+        void update(const nox::Duration& deltaTime);
+        void receiveEntityEvent(const nox::ecs::Event& event);
+
+        std::int64_t value{0};
+        std::uint32_t updateCount{0};
+    };
+}
@@ -0,0 +1,28 @@
+#include <components/name.h>
+
+#include <cstdint>
+
+#include <json/value.h>
+
+void
+components::Name::initialize(const Json::Value& value)
+{
+    this->name = value.get("name", "").asString();
+}
+
+void
+components::Name::writeBinary(std::ostream& stream) const
+{
+    const auto size = static_cast<std::uint32_t>(this->name.size());
+    stream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    stream.write(this->name.data(), size);
+}
+
+void
+components::Name::readBinary(std::istream& stream)
+{
+    std::uint32_t size = 0;
+    stream.read(reinterpret_cast<char*>(&size), sizeof(size));
+    this->name.resize(size);
+    stream.read(&this->name[0], size);
+}
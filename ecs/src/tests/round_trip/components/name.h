@@ -0,0 +1,26 @@
+#pragma once
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include <nox/ecs/Component.h>
+
+namespace components
+{
+    /**
+     * @brief      Holds a string, so it is not trivially copyable and is
+     *             snapshot through writeBinary and readBinary.
+     */
+    class Name
+        : public nox::ecs::Component
+    {
+    public:
+        using nox::ecs::Component::Component;
+
+        void initialize(const Json::Value& value);
+        void writeBinary(std::ostream& stream) const;
+        void readBinary(std::istream& stream);
+
+        std::string name{};
+    };
+}
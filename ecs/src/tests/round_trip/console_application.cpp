@@ -0,0 +1,345 @@
+#include <console_application.h>
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <string>
+
+#include <cmd/parser.h>
+#include <components/counter.h>
+#include <components/name.h>
+#include <nox/ecs/component/Children.h>
+#include <nox/ecs/component/Parent.h>
+#include <nox/ecs/ComponentType.h>
+#include <nox/ecs/createMetaInformation.h>
+#include <nox/ecs/TraceRecorder.h>
+#include <nox/ecs/TraceReplayer.h>
+
+#include <json/reader.h>
+
+namespace
+{
+    namespace local
+    {
+        const auto COUNTER = nox::ecs::TypeIdentifier(std::string("Counter"));
+        const auto NAME = nox::ecs::TypeIdentifier(std::string("Name"));
+
+        /**
+         * @brief      Every parent gets CHILD_COUNT children, so the manager
+         *             holds CHILD_COUNT + 1 entities per parent.
+         */
+        constexpr std::size_t CHILD_COUNT = 2;
+
+        /**
+         * @brief      Number of steps taken after populating, and after
+         *             loading the snapshot.
+         */
+        constexpr std::size_t STEP_COUNT = 16;
+
+        const auto DELTA_TIME = std::chrono::duration_cast<nox::Duration>(std::chrono::milliseconds(16));
+
+        const auto DEFINITIONS = R"({
+            "Parent": {
+                "components": {
+                    "Counter": { "value": 1 },
+                    "Name": { "name": "parent" },
+                    "Children": ["Child", "Child"]
+                }
+            },
+            "Child": {
+                "components": {
+                    "Counter": { "value": 100 },
+                    "Name": { "name": "child of a parent with a name too long for small string optimization" }
+                }
+            }
+        })";
+
+        template<class T>
+        T*
+        getComponent(nox::ecs::EntityManager& manager,
+                     const nox::ecs::EntityId& id,
+                     const nox::ecs::TypeIdentifier& identifier)
+        {
+            return static_cast<T*>(manager.getComponent(id, identifier).get());
+        }
+
+        /**
+         * @brief      Checks that both or neither of lhs and rhs exist, and
+         *             that they are equal according to equal if they do.
+         */
+        template<class T, class Equal>
+        bool
+        compare(const T* lhs, const T* rhs, const Equal& equal)
+        {
+            return (!lhs && !rhs) || (lhs && rhs && equal(*lhs, *rhs));
+        }
+
+        /**
+         * @brief      Compares the components of the first entityCount
+         *             entities of lhs with those of rhs. getRhsId maps an
+         *             entity id of lhs to the matching id of rhs.
+         */
+        template<class IdMap>
+        bool
+        compareManagers(nox::ecs::EntityManager& lhs,
+                        nox::ecs::EntityManager& rhs,
+                        std::size_t entityCount,
+                        const IdMap& getRhsId)
+        {
+            using components::Counter;
+            using components::Name;
+            using nox::ecs::Children;
+            using nox::ecs::Parent;
+            using nox::ecs::component_type::CHILDREN;
+            using nox::ecs::component_type::PARENT;
+
+            for (nox::ecs::EntityId id = 0; id < entityCount; ++id)
+            {
+                const auto rhsId = getRhsId(id);
+
+                const auto sameCounter = compare(getComponent<Counter>(lhs, id, COUNTER),
+                                                 getComponent<Counter>(rhs, rhsId, COUNTER),
+                                                 [](const Counter& a, const Counter& b)
+                                                 { return a.value == b.value && a.updateCount == b.updateCount; });
+
+                const auto sameName = compare(getComponent<Name>(lhs, id, NAME),
+                                              getComponent<Name>(rhs, rhsId, NAME),
+                                              [](const Name& a, const Name& b)
+                                              { return a.name == b.name; });
+
+                const auto sameChildren = compare(getComponent<Children>(lhs, id, CHILDREN),
+                                                  getComponent<Children>(rhs, rhsId, CHILDREN),
+                                                  [&getRhsId](const Children& a, const Children& b)
+                                                  {
+                                                      if (a.size() != b.size())
+                                                      {
+                                                          return false;
+                                                      }
+                                                      for (std::size_t i = 0; i < a.size(); ++i)
+                                                      {
+                                                          if (getRhsId(a[i]) != b[i])
+                                                          {
+                                                              return false;
+                                                          }
+                                                      }
+                                                      return true;
+                                                  });
+
+                const auto sameParent = compare(getComponent<Parent>(lhs, id, PARENT),
+                                                getComponent<Parent>(rhs, rhsId, PARENT),
+                                                [&getRhsId](const Parent& a, const Parent& b)
+                                                { return getRhsId(a.parentId) == b.parentId; });
+
+                if (!sameCounter || !sameName || !sameChildren || !sameParent)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+}
+
+ConsoleApplication::ConsoleApplication()
+    : Application("round_trip", "PTPERF")
+{
+}
+
+bool 
+ConsoleApplication::onInit()
+{
+    log = createLogger();
+    log.setName("ConsoleApplication");
+
+    const auto threadAmount = cmd::g_cmdParser.getIntArgument(cmd::constants::thread_amount_cmd,
+                                                              cmd::constants::thread_amount_default);
+    this->threadCount = static_cast<std::size_t>(std::max(threadAmount, 1));
+
+    const auto actorAmount = cmd::g_cmdParser.getIntArgument(cmd::constants::actor_amount_cmd,
+                                                             cmd::constants::actor_amount_default);
+    this->entityCount = static_cast<std::size_t>(std::max(actorAmount, 1));
+
+    Json::Reader reader;
+    if (!reader.parse(local::DEFINITIONS, this->definitions))
+    {
+        log.error().raw("Failed parsing the entity definitions.");
+        return false;
+    }
+
+    if (!this->runSnapshotScenario() ||
+        !this->runTraceScenario())
+    {
+        return false;
+    }
+
+    log.info().raw("All scenarios passed");
+    return true;
+}
+
+void 
+ConsoleApplication::onUpdate(const nox::Duration& /*deltaTime*/)
+{
+    quitApplication();
+}
+
+bool
+ConsoleApplication::runSnapshotScenario()
+{
+    using Clock = std::chrono::steady_clock;
+
+    nox::ecs::EntityManager original(this->threadCount);
+    this->registerComponents(original);
+    this->populate(original);
+
+    std::stringstream snapshot(std::ios::in | std::ios::out | std::ios::binary);
+    const auto saveStart = Clock::now();
+    if (!original.saveSnapshot(snapshot))
+    {
+        log.error().raw("Failed saving the snapshot.");
+        return false;
+    }
+    const auto saveEnd = Clock::now();
+
+    nox::ecs::EntityManager loaded(this->threadCount);
+    this->registerComponents(loaded);
+    const auto loadStart = Clock::now();
+    if (!loaded.loadSnapshot(snapshot))
+    {
+        log.error().raw("Failed loading the snapshot.");
+        return false;
+    }
+    const auto loadEnd = Clock::now();
+
+    log.info().format("Snapshot of %zu entities: %zu bytes, saved in %.2f ms, loaded in %.2f ms",
+                      this->entityCount * (local::CHILD_COUNT + 1),
+                      snapshot.str().size(),
+                      std::chrono::duration<double, std::milli>(saveEnd - saveStart).count(),
+                      std::chrono::duration<double, std::milli>(loadEnd - loadStart).count());
+
+    const auto totalCount = this->entityCount * (local::CHILD_COUNT + 1);
+    const auto sameId = [](const nox::ecs::EntityId& id) { return id; };
+    if (!local::compareManagers(original, loaded, totalCount, sameId))
+    {
+        log.error().raw("The loaded snapshot differs from the saved manager.");
+        return false;
+    }
+
+    // The lifecycle states must have survived as well, or the updates would differ.
+    for (std::size_t i = 0; i < local::STEP_COUNT; ++i)
+    {
+        original.step(local::DELTA_TIME);
+        loaded.step(local::DELTA_TIME);
+    }
+
+    if (!local::compareManagers(original, loaded, totalCount, sameId))
+    {
+        log.error().raw("The loaded snapshot diverged from the saved manager after stepping.");
+        return false;
+    }
+
+    return true;
+}
+
+bool
+ConsoleApplication::runTraceScenario()
+{
+    std::stringstream trace(std::ios::in | std::ios::out | std::ios::binary);
+    nox::ecs::EntityManager recorded(this->threadCount);
+    this->registerComponents(recorded);
+    {
+        nox::ecs::TraceRecorder recorder(trace);
+        recorded.setTraceRecorder(&recorder);
+        this->populate(recorded);
+        recorded.setTraceRecorder(nullptr);
+    }
+
+    std::stringstream replayTrace(std::ios::in | std::ios::out | std::ios::binary);
+    nox::ecs::EntityManager replayed(this->threadCount);
+    this->registerComponents(replayed);
+    nox::ecs::TraceReplayer replayer(replayed);
+    {
+        nox::ecs::TraceRecorder recorder(replayTrace);
+        replayed.setTraceRecorder(&recorder);
+        const auto success = replayer.replay(trace);
+        replayed.setTraceRecorder(nullptr);
+
+        if (!success)
+        {
+            log.error().raw("Failed replaying the trace.");
+            return false;
+        }
+    }
+
+    log.info().format("Trace of %zu entities: %zu bytes",
+                      this->entityCount * (local::CHILD_COUNT + 1),
+                      trace.str().size());
+
+    const auto totalCount = this->entityCount * (local::CHILD_COUNT + 1);
+    if (!local::compareManagers(recorded, replayed, totalCount,
+                                [&replayer](const nox::ecs::EntityId& id) { return replayer.getReplayedId(id); }))
+    {
+        log.error().raw("The replayed manager differs from the recorded one.");
+        return false;
+    }
+
+    if (trace.str() != replayTrace.str())
+    {
+        log.error().raw("Recording the replay gave a different trace.");
+        return false;
+    }
+
+    return true;
+}
+
+void
+ConsoleApplication::registerComponents(nox::ecs::EntityManager& manager) const
+{
+    manager.registerComponent(nox::ecs::createMetaInformation<components::Counter>(local::COUNTER));
+    manager.registerComponent(nox::ecs::createMetaInformation<components::Name>(local::NAME));
+    manager.registerComponent(nox::ecs::createMetaInformation<nox::ecs::Children>(nox::ecs::component_type::CHILDREN));
+    manager.registerComponent(nox::ecs::createMetaInformation<nox::ecs::Parent>(nox::ecs::component_type::PARENT));
+    manager.configureComponents();
+}
+
+void
+ConsoleApplication::populate(nox::ecs::EntityManager& manager) const
+{
+    manager.createEntityDefinition(this->definitions);
+    manager.createEntities("Parent", this->entityCount);
+    manager.step(local::DELTA_TIME);
+
+    // Leave entities in every lifecycle state: active, inactive and hibernating.
+    const auto totalCount = this->entityCount * (local::CHILD_COUNT + 1);
+    for (nox::ecs::EntityId id = 0; id < totalCount; ++id)
+    {
+        manager.awakeEntity(id);
+        if (id % 3 != 0)
+        {
+            manager.activateEntity(id);
+        }
+    }
+    manager.step(local::DELTA_TIME);
+
+    for (nox::ecs::EntityId id = 0; id < totalCount; id += 5)
+    {
+        if (id % 3 != 0)
+        {
+            manager.deactivateEntity(id);
+        }
+    }
+    manager.step(local::DELTA_TIME);
+
+    for (nox::ecs::EntityId id = 0; id < totalCount; id += 7)
+    {
+        if (id % 3 == 0 || id % 5 == 0)
+        {
+            manager.hibernateEntity(id);
+        }
+    }
+
+    for (std::size_t i = 0; i < local::STEP_COUNT; ++i)
+    {
+        manager.step(local::DELTA_TIME);
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+
+#include <nox/app/Application.h>
+#include <nox/ecs/EntityManager.h>
+#include <nox/log/Logger.h>
+
+#include <json/value.h>
+
+/**
+ * @brief      Checks that the state of a populated EntityManager survives a
+ *             snapshot save and load, and a trace record and replay.
+ */
+class ConsoleApplication 
+    : public nox::app::Application
+{
+public:
+    ConsoleApplication();
+
+    virtual bool onInit() override;
+    virtual void onUpdate(const nox::Duration& deltaTime) override;
+
+private:
+    /**
+     * @brief      Saves a snapshot of a populated manager, loads it into an
+     *             empty one, and compares the two, also after stepping both.
+     */
+    bool runSnapshotScenario();
+
+    /**
+     * @brief      Records populating and stepping a manager, replays the
+     *             trace into an empty one, and compares the two, along with
+     *             the trace recorded while replaying.
+     */
+    bool runTraceScenario();
+
+    /**
+     * @brief      Registers and configures the components of the scenarios.
+     */
+    void registerComponents(nox::ecs::EntityManager& manager) const;
+
+    /**
+     * @brief      Creates the entities, and moves them through the different
+     *             lifecycle states.
+     */
+    void populate(nox::ecs::EntityManager& manager) const;
+
+    nox::log::Logger log;
+    std::size_t threadCount{0};
+    std::size_t entityCount{0};
+    Json::Value definitions{};
+};